@@ -2,9 +2,11 @@
 #include "SimulationManager.h"
 #include "FieldModelPotentialMap.h"
 #include "FarnsworthFusorFieldModel.h"
+#include "FieldModelMappedVolume.h"
 #include "ParticleModelSFPS.h"
 #include "ReactionModelDD.h"
 #include "ReactionModelDT.h"
+#include "ReactionModelMultiChannel.h"
 #include "MagneticFieldUniform.h"
 #include "Visualizer.h"
 #include "PhysicalConstants.h"
@@ -12,6 +14,7 @@
 #include <string>
 #include <random>
 #include <cmath>
+#include <sstream>
 
 using namespace fusion;
 
@@ -24,6 +27,9 @@ int CLI::run(const int argc, char* argv[])
         std::cout << "Options:\n"
                   << "  --dd             Deuterium-Deuterium fusion\n"
                   << "  --dt             Deuterium-Tritium fusion\n"
+                  << "  --mix <D:T:He3>  Mixed fuel with the multi-channel reaction model, e.g. 1:1:0\n"
+                  << "  --electrons <n>  Add n electrons at the ion temperature\n"
+                  << "  --electron-subcycles <k> Electron substeps per time step (default: sqrt(m_D / m_e))\n"
                   << "  --fusor          Farnsworth Fusor mode (IEC)\n"
                   << "  --tmax <t>       Simulation time [s] (default: 1e-6)\n"
                   << "  --timestep <dt>  Time step [s] (default: 1e-10)\n"
@@ -32,7 +38,23 @@ int CLI::run(const int argc, char* argv[])
                   << "  --voltage <V>    Cathode voltage [V] for fusor (default: -30000)\n"
                   << "  --pressure <P>   Chamber pressure [mbar] (default: 0.2)\n"
                   << "  --threads <n>    Number of CPU threads (default: all available)\n"
-                  << "  --thermal       Enable thermal dynamics model\n";
+                  << "  --thermal       Enable thermal dynamics model\n"
+                  << "  --coulomb        Enable binary Coulomb collisions (Takizuka-Abe)\n"
+                  << "  --cellsize <m>   Cell size for Coulomb collision pairing [m] (default: 5e-3)\n"
+                  << "  --swept          Swept closest-approach test for fusion pairs over each step\n"
+                  << "  --prune          Skip fusion pairs that cannot reach the threshold energy of the reaction\n"
+                  << "  --neutron-tally  Tally neutral products on a detector sphere and drop them\n"
+                  << "  --chamber-radius <m>    Chamber radius for the neutron tally [m] (default: 0.1)\n"
+                  << "  --detector-distance <m> Detector distance from the centre [m] (default: 0.5)\n"
+                  << "  --diagnostics <n> Write energy, density, fusion and rate histograms every n steps\n"
+                  << "  --event-log <file> Write every fusion event to a binary event log\n"
+                  << "  --ac             Drive the fusor cathode with the resonant AC supply\n"
+                  << "  --drive-frequency <Hz> Frequency of the AC drive (default: 35000)\n"
+                  << "  --analytic       Exact Kepler orbit propagation in the fusor field (no magnetic field)\n"
+                  << "  --symmetry <mode> Simulate a reduced fusor domain: full, half, quadrant or octant (default: full)\n"
+                  << "  --wires          Resolve the cathode wires, ions hitting a wire are absorbed (not with --analytic)\n"
+                  << "  --sort <k>       Reorder particles along a Morton curve every k steps (default: off)\n"
+                  << "  --field-volume <file> Electric field from a PotentialMap potential volume (.vtk), scaled to --voltage\n";
         return 0;
         // ./FusionSim --fusor --dd --particles 1000 --tmax 1e-6 --timestep 1e-11 --voltage -30000 --pressure 0.023 --temperature 10000
     }
@@ -45,8 +67,27 @@ int CLI::run(const int argc, char* argv[])
     double pressure_mbar = 0.2;
     int numThreads = 0;
     std::string mode = "dd";
+    std::string fuelMix;
+    int n_electrons = 0;
+    int electronSubcycles = static_cast<int>(std::ceil(std::sqrt(constants::massDeuterium / constants::massElectron)));
     bool fusorMode = false;
     bool enableThermalDynamics = false;
+    bool enableCoulombCollisions = false;
+    double collisionCellSize = 5.0e-3;
+    bool sweptCollisions = false;
+    bool pairPruning = false;
+    bool analyticPropagation = false;
+    std::string symmetry = "full";
+    bool cathodeWires = false;
+    int sortInterval = 0;
+    bool neutronTally = false;
+    double chamberRadius = 0.1;
+    double detectorDistance = 0.5;
+    int diagnosticsInterval = 0;
+    std::string eventLogFile;
+    std::string fieldVolumeFile;
+    bool acDrive = false;
+    double driveFrequency = FarnsworthFusorFieldModel::defaultResonantFrequency;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -59,6 +100,18 @@ int CLI::run(const int argc, char* argv[])
         {
             mode = "dt";
         }
+        else if (arg == "--mix" && i + 1 < argc)
+        {
+            fuelMix = argv[++i];
+        }
+        else if (arg == "--electrons" && i + 1 < argc)
+        {
+            n_electrons = std::stoi(argv[++i]);
+        }
+        else if (arg == "--electron-subcycles" && i + 1 < argc)
+        {
+            electronSubcycles = std::stoi(argv[++i]);
+        }
         else if (arg == "--fusor")
         {
             fusorMode = true;
@@ -95,6 +148,70 @@ int CLI::run(const int argc, char* argv[])
         {
             enableThermalDynamics = true;
         }
+        else if (arg == "--coulomb")
+        {
+            enableCoulombCollisions = true;
+        }
+        else if (arg == "--cellsize" && i + 1 < argc)
+        {
+            collisionCellSize = std::stod(argv[++i]);
+        }
+        else if (arg == "--swept")
+        {
+            sweptCollisions = true;
+        }
+        else if (arg == "--prune")
+        {
+            pairPruning = true;
+        }
+        else if (arg == "--analytic")
+        {
+            analyticPropagation = true;
+        }
+        else if (arg == "--symmetry" && i + 1 < argc)
+        {
+            symmetry = argv[++i];
+        }
+        else if (arg == "--wires")
+        {
+            cathodeWires = true;
+        }
+        else if (arg == "--sort" && i + 1 < argc)
+        {
+            sortInterval = std::stoi(argv[++i]);
+        }
+        else if (arg == "--neutron-tally")
+        {
+            neutronTally = true;
+        }
+        else if (arg == "--chamber-radius" && i + 1 < argc)
+        {
+            chamberRadius = std::stod(argv[++i]);
+        }
+        else if (arg == "--detector-distance" && i + 1 < argc)
+        {
+            detectorDistance = std::stod(argv[++i]);
+        }
+        else if (arg == "--diagnostics" && i + 1 < argc)
+        {
+            diagnosticsInterval = std::stoi(argv[++i]);
+        }
+        else if (arg == "--event-log" && i + 1 < argc)
+        {
+            eventLogFile = argv[++i];
+        }
+        else if (arg == "--ac")
+        {
+            acDrive = true;
+        }
+        else if (arg == "--drive-frequency" && i + 1 < argc)
+        {
+            driveFrequency = std::stod(argv[++i]);
+        }
+        else if (arg == "--field-volume" && i + 1 < argc)
+        {
+            fieldVolumeFile = argv[++i];
+        }
     }
 
     if (timestep <= 0.0)
@@ -115,6 +232,84 @@ int CLI::run(const int argc, char* argv[])
         return 1;
     }
 
+    if (n_electrons < 0 || electronSubcycles < 1)
+    {
+        std::cerr << "Error: Electron count must be >= 0 and electron subcycles >= 1!" << std::endl;
+        return 1;
+    }
+
+    // fuel fractions of D, T and He3, pure deuterium unless a mix is given
+    double fuelFraction[3] = { 1.0, 0.0, 0.0 };
+    if (!fuelMix.empty())
+    {
+        std::istringstream parts(fuelMix);
+        std::string part;
+        double sum = 0.0;
+        int count = 0;
+        while (std::getline(parts, part, ':') && count < 3)
+        {
+            fuelFraction[count] = std::stod(part);
+            sum += fuelFraction[count++];
+        }
+        for (; count < 3; ++count)
+        {
+            fuelFraction[count] = 0.0;
+        }
+        if (sum <= 0.0 || fuelFraction[0] < 0.0 || fuelFraction[1] < 0.0 || fuelFraction[2] < 0.0)
+        {
+            std::cerr << "Error: Fuel mix must be non-negative parts D:T:He3 with a positive sum!" << std::endl;
+            return 1;
+        }
+        for (double& f : fuelFraction)
+        {
+            f /= sum;
+        }
+    }
+
+    SymmetryMode symmetryMode = SymmetryMode::FULL;
+    if (symmetry == "half")
+    {
+        symmetryMode = SymmetryMode::HALF;
+    }
+    else if (symmetry == "quadrant")
+    {
+        symmetryMode = SymmetryMode::QUADRANT;
+    }
+    else if (symmetry == "octant")
+    {
+        symmetryMode = SymmetryMode::OCTANT;
+    }
+    else if (symmetry != "full")
+    {
+        std::cerr << "Error: Unknown symmetry mode " << symmetry << " (full, half, quadrant, octant)!" << std::endl;
+        return 1;
+    }
+
+    if (symmetryMode != SymmetryMode::FULL && !fusorMode)
+    {
+        std::cerr << "Error: Symmetry reduction needs the spherically symmetric fusor field (--fusor)!" << std::endl;
+        return 1;
+    }
+
+    if (cathodeWires && (!fusorMode || symmetryMode != SymmetryMode::FULL))
+    {
+        std::cerr << "Error: Wire-resolved cathode needs --fusor and the full domain!" << std::endl;
+        return 1;
+    }
+
+    // the wire test follows the chord of each step, an analytic step covers a long curved arc
+    if (cathodeWires && analyticPropagation)
+    {
+        std::cerr << "Error: Wire-resolved cathode cannot be combined with --analytic!" << std::endl;
+        return 1;
+    }
+
+    if (!fieldVolumeFile.empty() && fusorMode)
+    {
+        std::cerr << "Error: --field-volume replaces the fusor field, use one of them!" << std::endl;
+        return 1;
+    }
+
     SimulationManager sim;
 
     if (numThreads > 0)
@@ -132,6 +327,59 @@ int CLI::run(const int argc, char* argv[])
         std::cerr << "Thermal dynamics model disabled.\n";
     }
 
+    if (enableCoulombCollisions)
+    {
+        if (collisionCellSize <= 0.0)
+        {
+            std::cerr << "Error: Collision cell size must be > 0!" << std::endl;
+            return 1;
+        }
+        sim.enableCoulombCollisions(true);
+        sim.setCollisionCellSize(collisionCellSize);
+        std::cout << "Binary Coulomb collisions enabled (cell size " << collisionCellSize * 1000.0 << " mm).\n";
+    }
+
+    if (sweptCollisions)
+    {
+        sim.enableSweptCollisionDetection(true);
+        std::cout << "Swept collision detection enabled for fusion pairs.\n";
+    }
+
+    if (pairPruning)
+    {
+        sim.enablePairPruning(true);
+        std::cout << "Fusion pairs below the reaction threshold energy are pruned.\n";
+    }
+
+    if (sortInterval > 0)
+    {
+        sim.setSortInterval(sortInterval);
+        std::cout << "Spatial reordering of particles every " << sortInterval << " steps.\n";
+    }
+
+    if (symmetryMode != SymmetryMode::FULL)
+    {
+        sim.setSymmetryMode(symmetryMode);
+        std::cout << "Symmetry reduction: " << symmetry << " domain, each particle stands for " << sim.getSymmetryDomain().getWeight() << ".\n";
+    }
+
+    if (analyticPropagation)
+    {
+        sim.enableAnalyticPropagation(true);
+        std::cout << "Analytic orbit propagation enabled for the fusor field.\n";
+    }
+
+    if (neutronTally)
+    {
+        if (chamberRadius <= 0.0 || detectorDistance < chamberRadius)
+        {
+            std::cerr << "Error: Detector distance must be >= chamber radius > 0!" << std::endl;
+            return 1;
+        }
+        sim.setNeutronTally(std::make_unique<NeutronTally>(chamberRadius, detectorDistance));
+        std::cout << "Neutron tally enabled (detector at " << detectorDistance * 100.0 << " cm).\n";
+    }
+
     std::shared_ptr<IFieldModel> fieldModel;
     std::shared_ptr<FarnsworthFusorFieldModel> fusorField = nullptr;
 
@@ -155,10 +403,22 @@ int CLI::run(const int argc, char* argv[])
             GridType::ROSENSTIEHL_SPHERICAL);
         fieldModel = fusorField;
 
+        if (cathodeWires)
+        {
+            auto wires = std::make_unique<GridWireGeometry>(innerGridRadius, wireDiameter, innerWireCount);
+            std::cout << "Wire-resolved cathode: " << wires->getRingCount() << " rings, " << wires->getSegmentCount() << " segments.\n";
+            sim.setCathodeWires(std::move(wires));
+        }
+
         double pressure_Pa_local = pressure_mbar * 100.0;
         fusorField->setOperatingPressure(pressure_Pa_local);
         fusorField->setGridTemperature(293.15);
         fusorField->setChamberTemperature(293.15);
+        fusorField->setResonantFrequency(driveFrequency);
+        if (acDrive)
+        {
+            fusorField->setDriveMode(DriveMode::RESONANT_AC);
+        }
 
         std::cout << "\n=== Farnsworth Fusor Configuration ===" << std::endl;
         std::cout << "Grid Geometry:" << std::endl;
@@ -173,6 +433,7 @@ int CLI::run(const int argc, char* argv[])
 
         std::cout << "\nElectrical Parameters:" << std::endl;
         std::cout << "  Cathode voltage: " << cathodeVoltage / 1000.0 << " kV" << std::endl;
+        std::cout << "  Drive: " << (acDrive ? "resonant AC" : "DC") << std::endl;
         std::cout << "  Resonant frequency: " << fusorField->getResonantFrequency() / 1000.0 << " kHz" << std::endl;
         std::cout << "  Peak-to-peak current: " << fusorField->getPeakToPeakCurrent() << " A" << std::endl;
 
@@ -234,6 +495,26 @@ int CLI::run(const int argc, char* argv[])
         std::cout << "  Chamber temp safe: " << (fusorField->isChamberTemperatureSafe() ? "Yes" : "No") << std::endl;
         std::cout << "===================================\n" << std::endl;
     }
+    else if (!fieldVolumeFile.empty())
+    {
+        auto volumeField = std::make_shared<FieldModelMappedVolume>(fieldVolumeFile);
+        if (!volumeField->open())
+        {
+            std::cerr << "Error: Unable to map potential volume " << fieldVolumeFile << "!" << std::endl;
+            return 1;
+        }
+
+        // Laplace's equation is linear, a map solved for one cathode potential serves every voltage
+        if (volumeField->getCathodePotential() != 0.0)
+        {
+            volumeField->setPotentialScale(cathodeVoltage / volumeField->getCathodePotential());
+        }
+
+        std::cout << "Potential volume " << fieldVolumeFile << ": " << volumeField->getDimension(0) << " x "
+                  << volumeField->getDimension(1) << " x " << volumeField->getDimension(2) << " nodes, spacing "
+                  << volumeField->getSpacing(0) * 1000.0 << " mm" << std::endl;
+        fieldModel = volumeField;
+    }
     else
     {
         fieldModel = std::make_shared<FieldModelPotentialMap>(1000.0);
@@ -264,7 +545,15 @@ int CLI::run(const int argc, char* argv[])
         std::cout << "Plasma frequency: " << plasmaFrequency / (2.0 * constants::pi * 1.0e6) << " MHz" << std::endl;
     }
 
-    if (mode == "dd")
+    if (!fuelMix.empty())
+    {
+        auto model = std::make_unique<ReactionModelMultiChannel>();
+        std::cout << "Reaction: " << model->getName() << std::endl;
+        std::cout << "Fuel mix: D " << fuelFraction[0] * 100.0 << " %, T " << fuelFraction[1] * 100.0
+                  << " %, He3 " << fuelFraction[2] * 100.0 << " %" << std::endl;
+        sim.setReactionModel(std::move(model));
+    }
+    else if (mode == "dd")
     {
         sim.setReactionModel(std::make_unique<ReactionModelDD>());
         std::cout << "Reaction: Deuterium-Deuterium" << std::endl;
@@ -293,7 +582,7 @@ int CLI::run(const int argc, char* argv[])
         innerRadius = 0.065;
     }
 
-    for (int i = 0; i < n_particles; ++i)
+    auto samplePosition = [&]()
     {
         double r;
         if (fusorMode)
@@ -308,10 +597,21 @@ int CLI::run(const int argc, char* argv[])
         const double theta = 2.0 * constants::pi * uniform(rng);
         const double phi = std::acos(2.0 * uniform(rng) - 1.0);
 
-        const Vector3d pos(
+        return Vector3d(
             r * std::sin(phi) * std::cos(theta),
             r * std::sin(phi) * std::sin(theta),
             r * std::cos(phi));
+    };
+
+    for (int i = 0; i < n_particles; ++i)
+    {
+        const double pick = uniform(rng);
+        const Species species = pick < fuelFraction[0] ? Species::DEUTERIUM
+            : (pick < fuelFraction[0] + fuelFraction[1] ? Species::TRITIUM : Species::HELIUM3);
+        // equal temperature, so the thermal speed scales with 1/sqrt(m)
+        const double speedScale = std::sqrt(constants::massDeuterium / SpeciesTable::get(species).mass);
+
+        const Vector3d pos = samplePosition();
 
         Vector3d vel;
         if (fusorMode)
@@ -342,13 +642,90 @@ int CLI::run(const int argc, char* argv[])
             vel = Vector3d(vdist(rng), vdist(rng), vdist(rng));
         }
 
-        sim.addParticle(std::make_unique<ParticleModelSFPS>(pos, vel, constants::massDeuterium, constants::eCharge, fieldModel, magFieldModel));
+        auto particle = std::make_unique<ParticleModelSFPS>(pos, vel * speedScale, species);
+        sim.getSymmetryDomain().fold(*particle);
+        sim.addParticle(std::move(particle));
+    }
+
+    if (n_electrons > 0)
+    {
+        // electrons start isotropic at the ion temperature and take their own substeps
+        const double electronSpeed = std::sqrt(constants::kBoltzmann * temperature / constants::massElectron);
+        std::normal_distribution<double> edist(0.0, electronSpeed);
+        for (int i = 0; i < n_electrons; ++i)
+        {
+            const Vector3d pos = samplePosition();
+            auto electron = std::make_unique<ParticleModelSFPS>(pos, Vector3d(edist(rng), edist(rng), edist(rng)), Species::ELECTRON);
+            sim.getSymmetryDomain().fold(*electron);
+            sim.addParticle(std::move(electron));
+        }
+        sim.setSubcycles(Species::ELECTRON, electronSubcycles);
+        std::cout << "Electrons: " << n_electrons << ", " << sim.getSubcycles(Species::ELECTRON) << " substeps of "
+                  << timestep / sim.getSubcycles(Species::ELECTRON) << " s per time step" << std::endl;
+    }
+
+    if (diagnosticsInterval > 0)
+    {
+        const double maxEnergy_keV = fusorMode ? std::abs(cathodeVoltage) / 1000.0 * 1.2 : 100.0;
+        sim.setDiagnostics(std::make_unique<Diagnostics>(diagnosticsInterval, spawnRadius * 1.5, maxEnergy_keV));
+        std::cout << "Diagnostics written every " << diagnosticsInterval << " steps to diag_*.csv" << std::endl;
+    }
+
+    if (!eventLogFile.empty())
+    {
+        auto eventLog = std::make_unique<FusionEventLog>(eventLogFile);
+        if (!eventLog->open(sim.getNumThreads()))
+        {
+            std::cerr << "Error: Unable to write fusion event log " << eventLogFile << "!" << std::endl;
+            return 1;
+        }
+        sim.setEventLog(std::move(eventLog));
+        std::cout << "Fusion events logged to " << eventLogFile << std::endl;
     }
 
     std::cout << "Running simulation for " << tmax << " s with dt = " << timestep << " s" << std::endl;
     sim.run(tmax, timestep);
 
     Visualizer::plot(sim.getParticles());
+
+    if (const FusionEventLog* log = sim.getEventLog())
+    {
+        if (log->isGood())
+        {
+            std::cout << "Fusion events logged: " << log->getEventCount() << " (" << eventLogFile << ")" << std::endl;
+        }
+        else
+        {
+            std::cerr << "Error: Writing fusion event log " << eventLogFile << " failed, the log is incomplete!" << std::endl;
+        }
+    }
+
+    if (const NeutronTally* tally = sim.getNeutronTally())
+    {
+        tally->writeHistograms("neutron_tally.csv");
+        tally->writeSamples("neutron_samples.csv");
+        std::cout << "Neutrons tallied: " << tally->getCount() << std::endl;
+        std::cout << "Neutron production rate: " << tally->getProductionRate() << " n/s" << std::endl;
+        std::cout << "Flux at detector: " << tally->getDetectorFlux() << " n/(s cm^2)" << std::endl;
+        std::cout << "Neutron histograms saved to neutron_tally.csv, samples to neutron_samples.csv." << std::endl;
+    }
+    std::cout << "Fusion reactions: " << sim.getReactionCount() << std::endl;
+    if (pairPruning && sim.getCandidatePairCount() > 0)
+    {
+        std::cout << "Fusion pairs pruned: " << sim.getPrunedPairCount() << " of " << sim.getCandidatePairCount()
+                  << " (" << 100.0 * sim.getPrunedPairCount() / sim.getCandidatePairCount() << " %)" << std::endl;
+    }
+    if (sortInterval > 0)
+    {
+        const SpatialSort& sort = sim.getSpatialSort();
+        std::cout << "Spatial sorts: " << sort.getSortCount()
+                  << ", neighbour gap " << sort.getGapBefore() * 1000.0 << " mm -> " << sort.getGapAfter() * 1000.0 << " mm"
+                  << ", push " << sim.getPushTimePerParticle(false) << " ns -> " << sim.getPushTimePerParticle(true) << " ns per particle" << std::endl;
+    }
+    if (cathodeWires)
+    {
+        std::cout << "Ions absorbed on cathode wires: " << sim.getWireHitCount() << std::endl;
+    }
     std::cout << "Simulation complete. Results saved to fusion_particles.csv." << std::endl;
     std::cout << "Final particle count: " << sim.getParticles().size() << std::endl;
 
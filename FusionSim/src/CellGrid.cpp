@@ -0,0 +1,65 @@
+#include "CellGrid.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fusion;
+
+namespace
+{
+    constexpr int64_t keyBits = 21;
+    constexpr int64_t keyOffset = int64_t(1) << (keyBits - 1);
+    constexpr uint64_t keyMask = (uint64_t(1) << keyBits) - 1;
+}
+
+uint64_t CellGrid::packKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+    const uint64_t ux = static_cast<uint64_t>(ix + keyOffset) & keyMask;
+    const uint64_t uy = static_cast<uint64_t>(iy + keyOffset) & keyMask;
+    const uint64_t uz = static_cast<uint64_t>(iz + keyOffset) & keyMask;
+    return (ux << (2 * keyBits)) | (uy << keyBits) | uz;
+}
+
+void CellGrid::build(const std::vector<std::unique_ptr<IParticleModel>>& particles, const double cellSize)
+{
+    const double invCell = 1.0 / cellSize;
+    const size_t n = particles.size();
+
+    m_keys.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Vector3d pos = particles[i]->getPosition();
+        const auto ix = static_cast<int64_t>(std::floor(pos.x * invCell));
+        const auto iy = static_cast<int64_t>(std::floor(pos.y * invCell));
+        const auto iz = static_cast<int64_t>(std::floor(pos.z * invCell));
+        m_keys[i] = { packKey(ix, iy, iz), i };
+    }
+
+    std::sort(m_keys.begin(), m_keys.end());
+
+    m_indices.resize(n);
+    m_cellStart.clear();
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i == 0 || m_keys[i].first != m_keys[i - 1].first)
+        {
+            m_cellStart.push_back(i);
+        }
+        m_indices[i] = m_keys[i].second;
+    }
+    m_cellStart.push_back(n);
+}
+
+size_t CellGrid::getCellCount() const
+{
+    return m_cellStart.empty() ? 0 : m_cellStart.size() - 1;
+}
+
+size_t* CellGrid::cellBegin(const size_t cell)
+{
+    return m_indices.data() + m_cellStart[cell];
+}
+
+size_t* CellGrid::cellEnd(const size_t cell)
+{
+    return m_indices.data() + m_cellStart[cell + 1];
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "IParticleModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Uniform spatial grid that buckets particle indices by cell. \class CellGrid
+    class CellGrid
+    {
+    public:
+        /**
+         * @brief Sort the particles into cubic cells of the given edge length.
+         * @param particles The particles to bucket.
+         * @param cellSize The cell edge length in meters.
+         */
+        void build(const std::vector<std::unique_ptr<IParticleModel>>& particles, double cellSize);
+
+        /**
+         * @brief Getter for the number of occupied cells.
+         * @return The number of cells holding at least one particle.
+         */
+        [[nodiscard]] size_t getCellCount() const;
+
+        /**
+         * @brief Getter for the first particle index of a cell.
+         * @param cell The cell number (0 to getCellCount() - 1).
+         * @return Pointer to the first particle index of the cell.
+         */
+        [[nodiscard]] size_t* cellBegin(size_t cell);
+
+        /**
+         * @brief Getter for the end of the particle indices of a cell.
+         * @param cell The cell number (0 to getCellCount() - 1).
+         * @return Pointer past the last particle index of the cell.
+         */
+        [[nodiscard]] size_t* cellEnd(size_t cell);
+
+        /**
+         * @brief Pack integer cell coordinates into a single key.
+         * @param ix Cell index along x.
+         * @param iy Cell index along y.
+         * @param iz Cell index along z.
+         * @return The packed 63 bit cell key.
+         */
+        static uint64_t packKey(int64_t ix, int64_t iy, int64_t iz);
+
+    private:
+        std::vector<size_t> m_indices;
+        std::vector<size_t> m_cellStart;
+        std::vector<std::pair<uint64_t, size_t>> m_keys;
+    };
+}
@@ -1,4 +1,5 @@
 #include "CollisionModel.h"
+#include "PhysicalConstants.h"
 #include <cmath>
 
 using namespace fusion;
@@ -49,4 +50,59 @@ void CollisionModel::inelasticCollision(IParticleModel& p1, IParticleModel& p2,
     const Vector3d v2_new = v_cm + reduction_factor * v2_rel;
     p1.setVelocity(v1_new);
     p2.setVelocity(v2_new);
-}
\ No newline at end of file
+}
+
+void CollisionModel::coulombCollision(IParticleModel& p1, IParticleModel& p2, const double density, const double coulombLogarithm, const double dt, std::mt19937& rng)
+{
+    const double q1 = p1.getCharge();
+    const double q2 = p2.getCharge();
+    if (q1 == 0.0 || q2 == 0.0)
+    {
+        return;
+    }
+
+    const double m1 = p1.getMass();
+    const double m2 = p2.getMass();
+    const Vector3d v1 = p1.getVelocity();
+    const Vector3d v2 = p2.getVelocity();
+    const Vector3d u = v1 - v2;
+    const double uMag = u.norm();
+    if (uMag < 1e-12)
+    {
+        return;
+    }
+
+    // variance of tan(theta/2) after Takizuka & Abe (1977)
+    const double reducedMass = (m1 * m2) / (m1 + m2);
+    const double variance = (q1 * q1 * q2 * q2 * density * coulombLogarithm * dt) /
+        (8.0 * constants::pi * constants::epsilon0 * constants::epsilon0 * reducedMass * reducedMass * uMag * uMag * uMag);
+
+    std::normal_distribution<double> deltaDist(0.0, std::sqrt(variance));
+    std::uniform_real_distribution<double> phiDist(0.0, 2.0 * constants::pi);
+
+    const double delta = deltaDist(rng);
+    const double phi = phiDist(rng);
+    const double sinTheta = 2.0 * delta / (1.0 + delta * delta);
+    const double oneMinusCosTheta = 2.0 * delta * delta / (1.0 + delta * delta);
+    const double cosPhi = std::cos(phi);
+    const double sinPhi = std::sin(phi);
+
+    const double uPerp = std::sqrt(u.x * u.x + u.y * u.y);
+    Vector3d du;
+    if (uPerp > 1e-12 * uMag)
+    {
+        du.x = (u.x / uPerp) * u.z * sinTheta * cosPhi - (u.y / uPerp) * uMag * sinTheta * sinPhi - u.x * oneMinusCosTheta;
+        du.y = (u.y / uPerp) * u.z * sinTheta * cosPhi + (u.x / uPerp) * uMag * sinTheta * sinPhi - u.y * oneMinusCosTheta;
+        du.z = -uPerp * sinTheta * cosPhi - u.z * oneMinusCosTheta;
+    }
+    else
+    {
+        // relative velocity along z, the rotation reduces to the trivial frame
+        du.x = uMag * sinTheta * cosPhi;
+        du.y = uMag * sinTheta * sinPhi;
+        du.z = -u.z * oneMinusCosTheta;
+    }
+
+    p1.setVelocity(v1 + (m2 / (m1 + m2)) * du);
+    p2.setVelocity(v2 - (m1 / (m1 + m2)) * du);
+}
@@ -2,6 +2,7 @@
 #include "IParticleModel.h"
 #include <vector>
 #include <memory>
+#include <random>
 
 /// @brief FusionSim - a simulator for FFR \namespace  fusion
 namespace fusion
@@ -25,5 +26,16 @@ namespace fusion
          * @param energyLoss Energy lost during the collision.
          */
         static void inelasticCollision(IParticleModel& p1, IParticleModel& p2, double energyLoss);
+
+        /**
+         * @brief Handle a small-angle binary Coulomb collision (Takizuka-Abe).
+         * @param p1 First particle.
+         * @param p2 Second particle.
+         * @param density Density of the background the pair represents in particles per cubic meter.
+         * @param coulombLogarithm The Coulomb logarithm ln(Lambda).
+         * @param dt Time step in seconds.
+         * @param rng Random number generator for the scattering angles.
+         */
+        static void coulombCollision(IParticleModel& p1, IParticleModel& p2, double density, double coulombLogarithm, double dt, std::mt19937& rng);
     };
 }
@@ -0,0 +1,163 @@
+#include "Diagnostics.h"
+#include "PhysicalConstants.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fusion;
+
+Diagnostics::Diagnostics(const size_t interval, const double maxRadius, const double maxEnergy_keV, std::string prefix,
+                         const size_t radialBins, const size_t energyBins)
+    : m_interval(std::max<size_t>(interval, 1))
+    , m_maxRadius(maxRadius)
+    , m_maxEnergy_keV(maxEnergy_keV)
+    , m_prefix(std::move(prefix))
+    , m_radialBins(radialBins)
+    , m_energyBins(energyBins)
+    , m_lastTime(0.0)
+    , m_lastReactionCount(0)
+{
+    m_shellVolumes.resize(m_radialBins);
+    const double dr = m_maxRadius / static_cast<double>(m_radialBins);
+    for (size_t b = 0; b < m_radialBins; ++b)
+    {
+        const double r0 = b * dr;
+        const double r1 = (b + 1) * dr;
+        m_shellVolumes[b] = 4.0 / 3.0 * constants::pi * (r1 * r1 * r1 - r0 * r0 * r0);
+    }
+}
+
+void Diagnostics::prepare(const int numThreads)
+{
+    m_accumulators.assign(std::max(numThreads, 1), Accumulator{
+        std::vector<double>(m_energyBins, 0.0),
+        std::vector<double>(m_radialBins, 0.0),
+        std::vector<double>(m_radialBins, 0.0) });
+    m_lastTime = 0.0;
+    m_lastReactionCount = 0;
+
+    m_energyOut.open(m_prefix + "_energy.csv");
+    m_radialOut.open(m_prefix + "_density.csv");
+    m_fusionOut.open(m_prefix + "_fusion.csv");
+    m_rateOut.open(m_prefix + "_rate.csv");
+
+    m_energyOut << "# ion energy spectrum, " << m_energyBins << " bins over [0, " << m_maxEnergy_keV << "] keV, columns named by bin centre in keV\n";
+    m_radialOut << "# ion density n(r) in sim particles per m^3, " << m_radialBins << " shells over [0, " << m_maxRadius << "] m, columns named by shell centre in m\n";
+    m_fusionOut << "# cumulative fusion events per shell, " << m_radialBins << " shells over [0, " << m_maxRadius << "] m, columns named by shell centre in m\n";
+    writeHeader(m_energyOut, m_maxEnergy_keV, m_energyBins);
+    writeHeader(m_radialOut, m_maxRadius, m_radialBins);
+    writeHeader(m_fusionOut, m_maxRadius, m_radialBins);
+    m_rateOut << "step,time,reactions,rate" << std::endl;
+}
+
+bool Diagnostics::isSampleStep(const size_t step) const
+{
+    return step % m_interval == 0;
+}
+
+void Diagnostics::writeHeader(std::ofstream& out, const double max, const size_t bins)
+{
+    const double width = max / static_cast<double>(bins);
+    out << "step,time";
+    for (size_t b = 0; b < bins; ++b)
+    {
+        out << "," << (b + 0.5) * width;
+    }
+    out << std::endl;
+}
+
+long long Diagnostics::binOf(const double value, const double max, const size_t bins)
+{
+    if (value < 0.0 || value >= max)
+    {
+        return -1;
+    }
+    return static_cast<long long>(value / max * static_cast<double>(bins));
+}
+
+void Diagnostics::accumulateParticle(const int thread, const IParticleModel& particle, const double weight)
+{
+    // the histograms are ion spectra, neutrals and electrons are not counted
+    if (particle.getCharge() <= 0.0)
+    {
+        return;
+    }
+
+    auto& acc = m_accumulators[thread];
+    const double energy_keV = 0.5 * particle.getMass() * particle.getVelocity().squaredNorm() / constants::keVtoJoule;
+    const long long eBin = binOf(energy_keV, m_maxEnergy_keV, m_energyBins);
+    if (eBin >= 0)
+    {
+        acc.energy[eBin] += weight;
+    }
+
+    const long long rBin = binOf(particle.getPosition().norm(), m_maxRadius, m_radialBins);
+    if (rBin >= 0)
+    {
+        acc.radial[rBin] += weight;
+    }
+}
+
+void Diagnostics::recordFusion(const int thread, const Vector3d& position, const double weight)
+{
+    const long long rBin = binOf(position.norm(), m_maxRadius, m_radialBins);
+    if (rBin >= 0)
+    {
+        m_accumulators[thread].fusion[rBin] += weight;
+    }
+}
+
+void Diagnostics::write(const size_t step, const double time, const size_t reactionCount)
+{
+    std::vector<double> energy(m_energyBins, 0.0);
+    std::vector<double> radial(m_radialBins, 0.0);
+    std::vector<double> fusion(m_radialBins, 0.0);
+
+    for (auto& acc : m_accumulators)
+    {
+        for (size_t b = 0; b < m_energyBins; ++b)
+        {
+            energy[b] += acc.energy[b];
+        }
+        for (size_t b = 0; b < m_radialBins; ++b)
+        {
+            radial[b] += acc.radial[b];
+            fusion[b] += acc.fusion[b];
+        }
+        // snapshot histograms restart, the fusion histogram stays cumulative
+        std::fill(acc.energy.begin(), acc.energy.end(), 0.0);
+        std::fill(acc.radial.begin(), acc.radial.end(), 0.0);
+    }
+
+    m_energyOut << step << "," << time;
+    for (const double v : energy)
+    {
+        m_energyOut << "," << v;
+    }
+    m_energyOut << "\n";
+
+    m_radialOut << step << "," << time;
+    for (size_t b = 0; b < m_radialBins; ++b)
+    {
+        m_radialOut << "," << radial[b] / m_shellVolumes[b];
+    }
+    m_radialOut << "\n";
+
+    m_fusionOut << step << "," << time;
+    for (const double v : fusion)
+    {
+        m_fusionOut << "," << v;
+    }
+    m_fusionOut << "\n";
+
+    const double elapsed = time - m_lastTime;
+    const size_t reactions = reactionCount - m_lastReactionCount;
+    const double rate = elapsed > 0.0 ? static_cast<double>(reactions) / elapsed : 0.0;
+    m_rateOut << step << "," << time << "," << reactions << "," << rate << "\n";
+    m_lastTime = time;
+    m_lastReactionCount = reactionCount;
+
+    m_energyOut.flush();
+    m_radialOut.flush();
+    m_fusionOut.flush();
+    m_rateOut.flush();
+}
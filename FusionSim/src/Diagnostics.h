@@ -0,0 +1,105 @@
+#pragma once
+#include "IParticleModel.h"
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief In-situ histograms accumulated per thread during a run. \class Diagnostics
+    class Diagnostics
+    {
+    public:
+        /**
+         * @brief Constructor for Diagnostics.
+         * @param interval Write the histograms every interval steps.
+         * @param maxRadius Outer radius of the radial histograms in meters.
+         * @param maxEnergy_keV Upper edge of the ion energy spectrum in keV.
+         * @param prefix Prefix for the output filenames.
+         * @param radialBins Number of radial bins.
+         * @param energyBins Number of energy bins.
+         */
+        Diagnostics(size_t interval, double maxRadius, double maxEnergy_keV, std::string prefix = "diag",
+                    size_t radialBins = 100, size_t energyBins = 200);
+
+        /**
+         * @brief Allocate the per-thread accumulators and open the output files.
+         * @param numThreads The number of threads that will accumulate.
+         */
+        void prepare(int numThreads);
+
+        /**
+         * @brief Check if the particle state of a step should be sampled.
+         * @param step The step number.
+         * @return True if the step is an output step.
+         */
+        [[nodiscard]] bool isSampleStep(size_t step) const;
+
+        /**
+         * @brief Add a particle to the snapshot histograms of the calling thread, neutrals and electrons are skipped.
+         * @param thread The calling thread number.
+         * @param particle The particle.
+         * @param weight Number of physical particles the simulated particle stands for.
+         */
+        void accumulateParticle(int thread, const IParticleModel& particle, double weight = 1.0);
+
+        /**
+         * @brief Add a fusion event to the cumulative fusion histogram of the calling thread.
+         * @param thread The calling thread number.
+         * @param position The fusion position.
+         * @param weight Number of physical events the simulated event stands for.
+         */
+        void recordFusion(int thread, const Vector3d& position, double weight = 1.0);
+
+        /**
+         * @brief Merge the thread accumulators and append a snapshot to the output files.
+         * @param step The step number.
+         * @param time The simulation time in seconds.
+         * @param reactionCount The total number of reactions so far.
+         */
+        void write(size_t step, double time, size_t reactionCount);
+
+    private:
+        /// @brief Histograms of one thread. \struct Accumulator
+        struct Accumulator
+        {
+            std::vector<double> energy;
+            std::vector<double> radial;
+            std::vector<double> fusion;
+        };
+
+        /**
+         * @brief Compute the histogram bin of a value, -1 if out of range.
+         * @param value The value.
+         * @param max Upper edge of the range starting at 0.
+         * @param bins Number of bins.
+         * @return The bin, or -1.
+         */
+        static long long binOf(double value, double max, size_t bins);
+
+        /**
+         * @brief Write the header row of a histogram file, one column per bin named by its centre.
+         * @param out The file.
+         * @param max Upper edge of the range starting at 0.
+         * @param bins Number of bins.
+         */
+        static void writeHeader(std::ofstream& out, double max, size_t bins);
+
+        size_t m_interval;
+        double m_maxRadius;
+        double m_maxEnergy_keV;
+        std::string m_prefix;
+        size_t m_radialBins;
+        size_t m_energyBins;
+        std::vector<Accumulator> m_accumulators;
+        std::vector<double> m_shellVolumes;
+        double m_lastTime;
+        size_t m_lastReactionCount;
+        std::ofstream m_energyOut;
+        std::ofstream m_radialOut;
+        std::ofstream m_fusionOut;
+        std::ofstream m_rateOut;
+    };
+}
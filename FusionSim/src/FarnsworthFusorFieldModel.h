@@ -1,6 +1,7 @@
 #pragma once
-#include "IFieldModel.h"
+#include "SeparableFieldModel.h"
 #include "PhysicalConstants.h"
+#include <algorithm>
 #include <cmath>
 
 /// @brief FusionSim - a simulator for FFR \namespace  fusion
@@ -23,8 +24,15 @@ namespace fusion
         MESH_GRID
     };
 
+    /// @brief Drive modes of the cathode supply. \enum DriveMode
+    enum class DriveMode
+    {
+        DC,
+        RESONANT_AC
+    };
+
     /// @brief Farnsworth Fusor Field Model. \class FarnsworthFusorFieldModel
-    class FarnsworthFusorFieldModel : public IFieldModel
+    class FarnsworthFusorFieldModel : public SeparableFieldModel
     {
     public:
         /// @brief Default inner grid radius in meters.
@@ -83,6 +91,8 @@ namespace fusion
             , m_currentGridTemp(28.00)
             , m_currentChamberTemp(25.00)
             , m_geometryFactor(calculateGeometryFactor())
+            , m_driveMode(DriveMode::DC)
+            , m_drivePhase(0.0)
         {
         }
 
@@ -122,15 +132,17 @@ namespace fusion
             , m_currentGridTemp(28.00)
             , m_currentChamberTemp(25.00)
             , m_geometryFactor(calculateGeometryFactor())
+            , m_driveMode(DriveMode::DC)
+            , m_drivePhase(0.0)
         {
         }
 
         /**
-         * @brief Getter for the electric field at a given position.
+         * @brief Getter for the electric field at a given position for a unit drive waveform.
          * @param position The position where the field is queried.
          * @return The electric field vector at the given position.
          */
-        [[nodiscard]] Vector3d getFieldAt(const Vector3d& position) const override
+        [[nodiscard]] Vector3d getSpatialFieldAt(const Vector3d& position) const override
         {
             const double r = position.norm();
 
@@ -148,6 +160,93 @@ namespace fusion
                 E_r * position.z * invR);
         }
 
+        /**
+         * @brief Time a straight flight stays inside the cathode or outside the anode, where the field vanishes.
+         * @param position The start position.
+         * @param velocity The velocity of the flight.
+         * @param maxTime The longest time of interest in seconds.
+         * @return 0 between the grids, otherwise the time until the grid is reached, at most maxTime.
+         */
+        [[nodiscard]] double getFieldFreeTime(const Vector3d& position, const Vector3d& velocity, const double maxTime) const override
+        {
+            const double r2 = position.squaredNorm();
+            const double ri2 = m_innerGridRadius * m_innerGridRadius;
+            const double ro2 = m_outerGridRadius * m_outerGridRadius;
+            if (r2 > ri2 && r2 <= ro2)
+            {
+                return 0.0;
+            }
+
+            const double a = velocity.squaredNorm();
+            if (a == 0.0)
+            {
+                return maxTime;
+            }
+
+            // |position + velocity * s|^2 = R^2, leave the cathode at the far root, enter the anode at the near root
+            const double b = position.dot(velocity);
+            if (r2 <= ri2)
+            {
+                const double disc = std::max(b * b - a * (r2 - ri2), 0.0);
+                return std::min(std::max((-b + std::sqrt(disc)) / a, 0.0), maxTime);
+            }
+
+            const double disc = b * b - a * (r2 - ro2);
+            if (b >= 0.0 || disc < 0.0)
+            {
+                return maxTime;
+            }
+            return std::min(std::max((-b - std::sqrt(disc)) / a, 0.0), maxTime);
+        }
+
+        /**
+         * @brief Getter for the drive waveform of the cathode voltage.
+         * @param time The simulation time in seconds.
+         * @return 1 for DC drive, sin(omega * t + phase) for the resonant AC supply.
+         */
+        [[nodiscard]] double getWaveform(const double time) const override
+        {
+            if (m_driveMode == DriveMode::RESONANT_AC)
+            {
+                const double omega = 2.0 * constants::pi * m_resonantFrequency;
+                return std::sin(omega * time + m_drivePhase);
+            }
+            return 1.0;
+        }
+
+        /**
+         * @brief Setter for the drive mode of the cathode supply.
+         * @param mode The drive mode.
+         * @param phase_rad Phase offset of the AC drive in radians.
+         */
+        void setDriveMode(const DriveMode mode, const double phase_rad = 0.0)
+        {
+            m_driveMode = mode;
+            m_drivePhase = phase_rad;
+            m_stepFactor = getWaveform(0.0);
+        }
+
+        /**
+         * @brief Getter for the drive mode.
+         * @return The drive mode.
+         */
+        [[nodiscard]] DriveMode getDriveMode() const { return m_driveMode; }
+
+        /**
+         * @brief Setter for the resonant frequency of the supply.
+         * @param frequency_Hz The frequency in Hz.
+         */
+        void setResonantFrequency(const double frequency_Hz) { m_resonantFrequency = frequency_Hz; }
+
+        /**
+         * @brief Getter for the constant of the central field between the grids, E_r(r) = K / r^2.
+         * @return K in volts for the current step, including the drive waveform.
+         */
+        [[nodiscard]] double getRadialFieldConstant() const
+        {
+            return m_cathodeVoltage * m_geometryFactor * m_stepFactor;
+        }
+
         /**
          * @brief Getter for the electric potential at a given radius.
          * @param r The radial distance from the center in meters.
@@ -505,5 +604,7 @@ namespace fusion
         double m_currentGridTemp;
         double m_currentChamberTemp;
         double m_geometryFactor;
+        DriveMode m_driveMode;
+        double m_drivePhase;
     };
 }
@@ -0,0 +1,14 @@
+#pragma once
+#include "IFieldModel.h"
+#include "IMagneticFieldModel.h"
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Fields of a simulation, referenced once per run and handed to the particle push. \struct FieldContext
+    struct FieldContext
+    {
+        const IFieldModel* electric = nullptr;
+        const IMagneticFieldModel* magnetic = nullptr;
+    };
+}
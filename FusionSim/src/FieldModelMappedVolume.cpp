@@ -0,0 +1,341 @@
+#include "FieldModelMappedVolume.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace fusion;
+
+namespace
+{
+    // the ASCII header of a legacy VTK file is short, anything longer is not one
+    constexpr size_t maxHeaderSize = 4096;
+
+    inline float fromBigEndian(const unsigned char* bytes)
+    {
+        const uint32_t bits = (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16)
+                            | (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+FieldModelMappedVolume::FieldModelMappedVolume(std::string filename)
+    : m_filename(std::move(filename))
+    , m_data(nullptr)
+    , m_mapping(nullptr)
+    , m_mappedSize(0)
+#ifdef _WIN32
+    , m_fileHandle(nullptr)
+    , m_mappingHandle(nullptr)
+#endif
+    , m_dims{ 0, 0, 0 }
+    , m_origin{ 0.0, 0.0, 0.0 }
+    , m_spacing{ 1.0, 1.0, 1.0 }
+    , m_scale(1.0)
+    , m_cathodePotential(0.0)
+{
+}
+
+FieldModelMappedVolume::~FieldModelMappedVolume()
+{
+#ifdef _WIN32
+    if (m_mapping)
+    {
+        UnmapViewOfFile(m_mapping);
+    }
+    if (m_mappingHandle)
+    {
+        CloseHandle(m_mappingHandle);
+    }
+    if (m_fileHandle && m_fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_fileHandle);
+    }
+#else
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappedSize);
+    }
+#endif
+}
+
+bool FieldModelMappedVolume::open()
+{
+#ifdef _WIN32
+    m_fileHandle = CreateFileA(m_filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_fileHandle, &size) || size.QuadPart == 0)
+    {
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mappingHandle)
+    {
+        return false;
+    }
+
+    m_mapping = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!m_mapping)
+    {
+        return false;
+    }
+    m_mappedSize = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(m_filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // the mapping keeps its own reference to the file
+    void* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_mappedSize = static_cast<size_t>(info.st_size);
+#endif
+
+    const auto* bytes = static_cast<const unsigned char*>(m_mapping);
+    const std::string header(reinterpret_cast<const char*>(bytes), std::min(m_mappedSize, maxHeaderSize));
+
+    std::istringstream lines(header);
+    std::string line;
+    size_t offset = 0;
+    size_t points = 0;
+    bool binary = false;
+    bool structuredPoints = false;
+    bool floatScalars = false;
+    bool dataFound = false;
+
+    for (int lineNumber = 0; !dataFound && std::getline(lines, line); ++lineNumber)
+    {
+        offset += line.size() + 1;
+
+        if (lineNumber == 0)
+        {
+            if (line.rfind("# vtk DataFile", 0) != 0)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        // PotentialMap names the cathode potential in the free-form title line
+        if (lineNumber == 1)
+        {
+            const size_t pos = line.find("cathode ");
+            if (pos != std::string::npos)
+            {
+                m_cathodePotential = std::strtod(line.c_str() + pos + 8, nullptr);
+            }
+            continue;
+        }
+
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+
+        if (keyword == "BINARY")
+        {
+            binary = true;
+        }
+        else if (keyword == "DATASET")
+        {
+            std::string type;
+            words >> type;
+            structuredPoints = type == "STRUCTURED_POINTS";
+        }
+        else if (keyword == "DIMENSIONS")
+        {
+            words >> m_dims[0] >> m_dims[1] >> m_dims[2];
+        }
+        else if (keyword == "ORIGIN")
+        {
+            words >> m_origin[0] >> m_origin[1] >> m_origin[2];
+        }
+        else if (keyword == "SPACING" || keyword == "ASPECT_RATIO")
+        {
+            words >> m_spacing[0] >> m_spacing[1] >> m_spacing[2];
+        }
+        else if (keyword == "POINT_DATA")
+        {
+            words >> points;
+        }
+        else if (keyword == "SCALARS")
+        {
+            std::string name, type;
+            int components = 1;
+            words >> name >> type;
+            if (!(words >> components))
+            {
+                components = 1;
+            }
+            floatScalars = type == "float" && components == 1;
+        }
+        else if (keyword == "LOOKUP_TABLE")
+        {
+            dataFound = true;
+        }
+    }
+
+    if (!dataFound || !binary || !structuredPoints || !floatScalars)
+    {
+        return false;
+    }
+
+    const size_t nodes = static_cast<size_t>(m_dims[0]) * m_dims[1] * m_dims[2];
+    if (m_dims[0] < 2 || m_dims[1] < 2 || m_dims[2] < 2 || nodes != points || offset + nodes * sizeof(float) > m_mappedSize
+        || m_spacing[0] <= 0.0 || m_spacing[1] <= 0.0 || m_spacing[2] <= 0.0)
+    {
+        return false;
+    }
+
+    m_data = bytes + offset;
+    return true;
+}
+
+double FieldModelMappedVolume::node(const int i, const int j, const int k) const
+{
+    const size_t index = (static_cast<size_t>(k) * m_dims[1] + j) * m_dims[0] + i;
+    return fromBigEndian(m_data + index * sizeof(float));
+}
+
+bool FieldModelMappedVolume::locate(const int axis, const double p, int& cell, double& t) const
+{
+    const double g = (p - m_origin[axis]) / m_spacing[axis];
+    const int last = m_dims[axis] - 1;
+
+    if (g < 0.0 || g > last)
+    {
+        return false;
+    }
+
+    cell = std::min(static_cast<int>(g), last - 1);
+    t = g - cell;
+    return true;
+}
+
+Vector3d FieldModelMappedVolume::getFieldAt(const Vector3d& position) const
+{
+    int cell[3];
+    double t[3];
+
+    if (!m_data || !locate(0, position.x, cell[0], t[0]) || !locate(1, position.y, cell[1], t[1]) || !locate(2, position.z, cell[2], t[2]))
+    {
+        return Vector3d(0.0, 0.0, 0.0);
+    }
+
+    Vector3d gradient(0.0, 0.0, 0.0);
+
+    for (int dk = 0; dk < 2; ++dk)
+    {
+        for (int dj = 0; dj < 2; ++dj)
+        {
+            for (int di = 0; di < 2; ++di)
+            {
+                const int n[3] = { cell[0] + di, cell[1] + dj, cell[2] + dk };
+                const double w = (di ? t[0] : 1.0 - t[0]) * (dj ? t[1] : 1.0 - t[1]) * (dk ? t[2] : 1.0 - t[2]);
+
+                // central differences, one-sided on the faces of the volume
+                double g[3];
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    int lo[3] = { n[0], n[1], n[2] };
+                    int hi[3] = { n[0], n[1], n[2] };
+                    lo[axis] = std::max(n[axis] - 1, 0);
+                    hi[axis] = std::min(n[axis] + 1, m_dims[axis] - 1);
+
+                    g[axis] = (node(hi[0], hi[1], hi[2]) - node(lo[0], lo[1], lo[2])) / ((hi[axis] - lo[axis]) * m_spacing[axis]);
+                }
+
+                gradient.x += w * g[0];
+                gradient.y += w * g[1];
+                gradient.z += w * g[2];
+            }
+        }
+    }
+
+    return Vector3d(-m_scale * gradient.x, -m_scale * gradient.y, -m_scale * gradient.z);
+}
+
+double FieldModelMappedVolume::getPotentialAt(const Vector3d& position) const
+{
+    int cell[3];
+    double t[3];
+
+    if (!m_data || !locate(0, position.x, cell[0], t[0]) || !locate(1, position.y, cell[1], t[1]) || !locate(2, position.z, cell[2], t[2]))
+    {
+        return 0.0;
+    }
+
+    double potential = 0.0;
+
+    for (int dk = 0; dk < 2; ++dk)
+    {
+        for (int dj = 0; dj < 2; ++dj)
+        {
+            for (int di = 0; di < 2; ++di)
+            {
+                const double w = (di ? t[0] : 1.0 - t[0]) * (dj ? t[1] : 1.0 - t[1]) * (dk ? t[2] : 1.0 - t[2]);
+                potential += w * node(cell[0] + di, cell[1] + dj, cell[2] + dk);
+            }
+        }
+    }
+
+    return m_scale * potential;
+}
+
+void FieldModelMappedVolume::setPotentialScale(const double scale)
+{
+    m_scale = scale;
+}
+
+double FieldModelMappedVolume::getCathodePotential() const
+{
+    return m_cathodePotential;
+}
+
+int FieldModelMappedVolume::getDimension(const int axis) const
+{
+    return m_dims[axis];
+}
+
+double FieldModelMappedVolume::getSpacing(const int axis) const
+{
+    return m_spacing[axis];
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "IFieldModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Electric field from a potential volume written by PotentialMap, memory-mapped so the pages load on demand. \class FieldModelMappedVolume
+    class FieldModelMappedVolume : public IFieldModel
+    {
+    public:
+        /**
+         * @brief Constructor for FieldModelMappedVolume, the file is mapped by open().
+         * @param filename A legacy VTK structured-points file with one binary float scalar per node.
+         */
+        explicit FieldModelMappedVolume(std::string filename);
+
+        /**
+         * @brief Destructor, unmaps the file.
+         */
+        ~FieldModelMappedVolume() override;
+
+        FieldModelMappedVolume(const FieldModelMappedVolume&) = delete;
+        FieldModelMappedVolume& operator=(const FieldModelMappedVolume&) = delete;
+
+        /**
+         * @brief Map the file and read its header.
+         * @return False if the file is missing or not a binary float structured-points volume.
+         */
+        bool open();
+
+        /**
+         * @brief Getter for the electric field at a given position.
+         * Node gradients by central differences, blended trilinearly. Zero outside the volume.
+         * @param position The position where the field is queried.
+         * @return The electric field vector at the given position.
+         */
+        [[nodiscard]] Vector3d getFieldAt(const Vector3d& position) const override;
+
+        /**
+         * @brief Getter for the interpolated potential.
+         * @param position The position.
+         * @return The potential in volts, scaled, zero outside the volume.
+         */
+        [[nodiscard]] double getPotentialAt(const Vector3d& position) const;
+
+        /**
+         * @brief Setter for the factor applied to the stored potential, e.g. to rescale a map to another cathode voltage.
+         * @param scale The factor.
+         */
+        void setPotentialScale(double scale);
+
+        /**
+         * @brief Getter for the cathode potential recorded in the file title.
+         * @return The potential in volts, 0 if the title does not give one.
+         */
+        [[nodiscard]] double getCathodePotential() const;
+
+        /**
+         * @brief Getter for the number of nodes along an axis.
+         * @param axis 0, 1 or 2 for x, y, z.
+         * @return The node count.
+         */
+        [[nodiscard]] int getDimension(int axis) const;
+
+        /**
+         * @brief Getter for the node spacing along an axis.
+         * @param axis 0, 1 or 2 for x, y, z.
+         * @return The spacing in meters.
+         */
+        [[nodiscard]] double getSpacing(int axis) const;
+
+    private:
+        /**
+         * @brief Stored potential of a node, unscaled. The file is big-endian.
+         * @param i Node index along x.
+         * @param j Node index along y.
+         * @param k Node index along z.
+         * @return The potential in volts.
+         */
+        [[nodiscard]] double node(int i, int j, int k) const;
+
+        /**
+         * @brief Locate a coordinate in the grid.
+         * @param axis 0, 1 or 2 for x, y, z.
+         * @param p The coordinate in meters.
+         * @param cell Output, index of the lower node of the cell.
+         * @param t Output, position inside the cell, 0 to 1.
+         * @return False outside the volume.
+         */
+        bool locate(int axis, double p, int& cell, double& t) const;
+
+        std::string m_filename;
+        const unsigned char* m_data;
+        void* m_mapping;
+        size_t m_mappedSize;
+#ifdef _WIN32
+        void* m_fileHandle;
+        void* m_mappingHandle;
+#endif
+        int m_dims[3];
+        double m_origin[3];
+        double m_spacing[3];
+        double m_scale;
+        double m_cathodePotential;
+    };
+}
@@ -0,0 +1,146 @@
+#include "FusionEventLog.h"
+#include <algorithm>
+
+using namespace fusion;
+
+FusionEventLog::FusionEventLog(std::string filename, const size_t batchSize)
+    : m_filename(std::move(filename))
+    , m_batchSize(std::max<size_t>(batchSize, 1))
+    , m_eventCount(0)
+    , m_stop(false)
+    , m_failed(false)
+{
+}
+
+FusionEventLog::~FusionEventLog()
+{
+    close();
+}
+
+bool FusionEventLog::open(const int numThreads)
+{
+    close();
+
+    m_threadBuffers.assign(std::max(numThreads, 1), {});
+    m_eventCount = 0;
+    m_stop = false;
+    m_failed = false;
+
+    m_out.open(m_filename, std::ios::binary | std::ios::trunc);
+    const uint32_t recordSize = sizeof(FusionEventRecord);
+    m_out.write(magic, sizeof(magic));
+    m_out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    m_out.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    m_out.flush();
+
+    if (!m_out)
+    {
+        m_failed = true;
+        m_out.close();
+        return false;
+    }
+
+    m_writer = std::thread(&FusionEventLog::writerLoop, this);
+    return true;
+}
+
+void FusionEventLog::append(const int thread, const FusionEventRecord& record)
+{
+    m_threadBuffers[thread].push_back(record);
+}
+
+void FusionEventLog::commit()
+{
+    size_t buffered = 0;
+    for (const auto& buffer : m_threadBuffers)
+    {
+        buffered += buffer.size();
+    }
+
+    if (buffered >= m_batchSize)
+    {
+        handOff();
+    }
+}
+
+void FusionEventLog::handOff()
+{
+    std::vector<FusionEventRecord> batch;
+    for (auto& buffer : m_threadBuffers)
+    {
+        batch.insert(batch.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+    }
+
+    if (batch.empty())
+    {
+        return;
+    }
+
+    m_eventCount += batch.size();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(batch));
+    }
+    m_cv.notify_one();
+}
+
+void FusionEventLog::writerLoop()
+{
+    while (true)
+    {
+        std::vector<FusionEventRecord> batch;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty())
+            {
+                return;
+            }
+            batch = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        m_out.write(reinterpret_cast<const char*>(batch.data()), static_cast<std::streamsize>(batch.size() * sizeof(FusionEventRecord)));
+        if (!m_out)
+        {
+            m_failed = true;
+        }
+    }
+}
+
+void FusionEventLog::close()
+{
+    if (!m_writer.joinable())
+    {
+        return;
+    }
+
+    handOff();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_writer.join();
+    m_out.close();
+    if (m_out.fail())
+    {
+        m_failed = true;
+    }
+}
+
+bool FusionEventLog::isOpen() const
+{
+    return m_writer.joinable();
+}
+
+bool FusionEventLog::isGood() const
+{
+    return !m_failed;
+}
+
+size_t FusionEventLog::getEventCount() const
+{
+    return m_eventCount;
+}
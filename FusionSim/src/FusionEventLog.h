@@ -0,0 +1,122 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Fixed-size binary record of one fusion event. \struct FusionEventRecord
+    /// In a reduced symmetry domain the position is folded into the domain and the event stands for weight events of the full sphere.
+    struct FusionEventRecord
+    {
+        double time;
+        float position[3];
+        float energyCM_keV;
+        uint16_t branch;
+        uint16_t productCount;
+        float productMass_amu[2];
+        float productCharge_e[2];
+        float productEnergy_MeV[2];
+        uint32_t weight;
+    };
+
+    static_assert(sizeof(FusionEventRecord) == 56, "FusionEventRecord must keep its on-disk layout");
+
+    /// @brief Binary fusion event log fed by per-thread buffers and written asynchronously. \class FusionEventLog
+    class FusionEventLog
+    {
+    public:
+        /// @brief Magic bytes at the start of every event log file.
+        static constexpr char magic[8] = { 'F', 'S', 'E', 'V', 'L', 'O', 'G', '\0' };
+
+        /// @brief Version of the file layout, 2 added the event weight.
+        static constexpr uint32_t version = 2;
+
+        /**
+         * @brief Constructor for FusionEventLog.
+         * @param filename The output filename.
+         * @param batchSize Number of buffered records that triggers a hand-off to the writer thread.
+         */
+        explicit FusionEventLog(std::string filename, size_t batchSize = 4096);
+
+        /**
+         * @brief Destructor, flushes the remaining records and joins the writer thread.
+         */
+        ~FusionEventLog();
+
+        FusionEventLog(const FusionEventLog&) = delete;
+        FusionEventLog& operator=(const FusionEventLog&) = delete;
+
+        /**
+         * @brief Open the file, write the header and start the writer thread.
+         * @param numThreads The number of threads that will append events.
+         * @return False if the file cannot be written, no writer is started then.
+         */
+        bool open(int numThreads);
+
+        /**
+         * @brief Append an event to the buffer of the calling thread, no locking.
+         * @param thread The calling thread number.
+         * @param record The event.
+         */
+        void append(int thread, const FusionEventRecord& record);
+
+        /**
+         * @brief Hand the buffered records to the writer thread if the batch is full. Call from a serial section.
+         */
+        void commit();
+
+        /**
+         * @brief Hand all buffered records to the writer, wait for them to be written and close the file.
+         */
+        void close();
+
+        /**
+         * @brief Getter for the state of the writer.
+         * @return True between a successful open() and close().
+         */
+        [[nodiscard]] bool isOpen() const;
+
+        /**
+         * @brief Getter for the state of the file.
+         * @return False if opening or any write failed.
+         */
+        [[nodiscard]] bool isGood() const;
+
+        /**
+         * @brief Getter for the number of events logged so far.
+         * @return The number of committed events.
+         */
+        [[nodiscard]] size_t getEventCount() const;
+
+    private:
+        /**
+         * @brief Move all thread buffers into one batch and queue it for writing.
+         */
+        void handOff();
+
+        /**
+         * @brief Writer thread loop.
+         */
+        void writerLoop();
+
+        std::string m_filename;
+        size_t m_batchSize;
+        size_t m_eventCount;
+        std::vector<std::vector<FusionEventRecord>> m_threadBuffers;
+        std::ofstream m_out;
+        std::thread m_writer;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<std::vector<FusionEventRecord>> m_queue;
+        bool m_stop;
+        bool m_failed;
+    };
+}
@@ -0,0 +1,334 @@
+#include "FusorOrbitPropagator.h"
+#include "PhysicalConstants.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fusion;
+
+// Between the grids E_r = K / r^2, which is the Kepler problem with mu = -(q/m) K. The orbit is advanced with
+// universal variables (f and g functions), grid crossings are found from the conic in closed form. Inside the
+// cathode and outside the anode the particle drifts in a straight line.
+
+namespace
+{
+    constexpr double parabolicTolerance = 1e-10;
+    constexpr int maxNewtonIterations = 60;
+}
+
+FusorOrbitPropagator::FusorOrbitPropagator(const FarnsworthFusorFieldModel& field)
+    : m_field(field)
+{
+}
+
+double FusorOrbitPropagator::stumpffS(const double z)
+{
+    if (z > 1e-6)
+    {
+        const double sz = std::sqrt(z);
+        return (sz - std::sin(sz)) / (sz * sz * sz);
+    }
+    if (z < -1e-6)
+    {
+        const double sz = std::sqrt(-z);
+        return (std::sinh(sz) - sz) / (sz * sz * sz);
+    }
+    return 1.0 / 6.0 - z / 120.0 + z * z / 5040.0;
+}
+
+double FusorOrbitPropagator::stumpffC(const double z)
+{
+    if (z > 1e-6)
+    {
+        return (1.0 - std::cos(std::sqrt(z))) / z;
+    }
+    if (z < -1e-6)
+    {
+        return (std::cosh(std::sqrt(-z)) - 1.0) / (-z);
+    }
+    return 0.5 - z / 24.0 + z * z / 720.0;
+}
+
+bool FusorOrbitPropagator::propagate(Vector3d& position, Vector3d& velocity, const double chargeOverMass, const double dt) const
+{
+    const double mu = -chargeOverMass * m_field.getRadialFieldConstant();
+    if (mu < 0.0)
+    {
+        return false;
+    }
+
+    if (mu == 0.0)
+    {
+        position += velocity * dt;
+        return true;
+    }
+
+    const double ri = m_field.getInnerGridRadius();
+    const double ro = m_field.getOuterGridRadius();
+    const double r = position.norm();
+
+    Region region = Region::BETWEEN_GRIDS;
+    if (r < ri)
+    {
+        region = Region::INSIDE_CATHODE;
+    }
+    else if (r > ro)
+    {
+        region = Region::OUTSIDE_ANODE;
+    }
+
+    Vector3d pos = position;
+    Vector3d vel = velocity;
+    double remaining = dt;
+
+    for (int segment = 0; segment < maxSegments && remaining > 0.0; ++segment)
+    {
+        double used = 0.0;
+        if (region == Region::BETWEEN_GRIDS)
+        {
+            if (!keplerSegment(pos, vel, mu, region, remaining, used))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            used = driftSegment(pos, vel, region, remaining);
+        }
+        remaining -= used;
+    }
+
+    if (remaining > 0.0)
+    {
+        return false;
+    }
+
+    position = pos;
+    velocity = vel;
+    return true;
+}
+
+double FusorOrbitPropagator::driftSegment(Vector3d& r, const Vector3d& v, Region& region, const double tau) const
+{
+    const double a = v.squaredNorm();
+    if (a == 0.0)
+    {
+        return tau;
+    }
+
+    const double b = r.dot(v);
+    double crossing = -1.0;
+
+    if (region == Region::INSIDE_CATHODE)
+    {
+        const double radius = m_field.getInnerGridRadius();
+        const double c = r.squaredNorm() - radius * radius;
+        const double disc = std::max(b * b - a * c, 0.0);
+        crossing = std::max((-b + std::sqrt(disc)) / a, 0.0);
+        if (crossing < tau)
+        {
+            r += v * crossing;
+            r *= radius / r.norm();
+            region = Region::BETWEEN_GRIDS;
+            return crossing;
+        }
+    }
+    else if (b < 0.0)
+    {
+        const double radius = m_field.getOuterGridRadius();
+        const double c = r.squaredNorm() - radius * radius;
+        const double disc = b * b - a * c;
+        if (disc >= 0.0)
+        {
+            crossing = std::max((-b - std::sqrt(disc)) / a, 0.0);
+            if (crossing < tau)
+            {
+                r += v * crossing;
+                r *= radius / r.norm();
+                region = Region::BETWEEN_GRIDS;
+                return crossing;
+            }
+        }
+    }
+
+    r += v * tau;
+    return tau;
+}
+
+double FusorOrbitPropagator::crossingAnomaly(const double r0, const double sigma0, const double alpha, const double radius, const bool outward)
+{
+    if (std::abs(alpha) * r0 < parabolicTolerance)
+    {
+        // r(chi) = chi^2 / 2 + sigma0 chi + r0, dr/dchi = chi + sigma0
+        const double disc = sigma0 * sigma0 - 2.0 * (r0 - radius);
+        if (disc < 0.0)
+        {
+            return -1.0;
+        }
+        return outward ? -sigma0 + std::sqrt(disc) : -sigma0 - std::sqrt(disc);
+    }
+
+    if (alpha > 0.0)
+    {
+        // ellipse: r = a (1 - e cos E), outward while sin E > 0
+        const double sqrtAlpha = std::sqrt(alpha);
+        const double eCos = 1.0 - r0 * alpha;
+        const double eSin = sigma0 * sqrtAlpha;
+        const double e = std::hypot(eCos, eSin);
+        if (e < 1e-14)
+        {
+            return -1.0;
+        }
+
+        const double c = (1.0 - radius * alpha) / e;
+        if (c < -1.0 || c > 1.0)
+        {
+            return -1.0;
+        }
+
+        const double e0 = std::atan2(eSin, eCos);
+        const double base = outward ? std::acos(c) : -std::acos(c);
+        const double twoPi = 2.0 * constants::pi;
+        double anomaly = base + twoPi * std::ceil((e0 - base) / twoPi);
+        if (anomaly <= e0)
+        {
+            anomaly += twoPi;
+        }
+        return (anomaly - e0) / sqrtAlpha;
+    }
+
+    // hyperbola: r = a (1 - e cosh F) with a < 0, outward while sinh F > 0
+    const double sqrtMinusAlpha = std::sqrt(-alpha);
+    const double eCosh = 1.0 - r0 * alpha;
+    const double eSinh = sigma0 * sqrtMinusAlpha;
+    const double e = std::sqrt(std::max(eCosh * eCosh - eSinh * eSinh, 0.0));
+    const double c = (1.0 - radius * alpha) / e;
+    if (c < 1.0)
+    {
+        return -1.0;
+    }
+
+    const double f0 = std::asinh(eSinh / e);
+    const double anomaly = outward ? std::acosh(c) : -std::acosh(c);
+    return anomaly > f0 ? (anomaly - f0) / sqrtMinusAlpha : -1.0;
+}
+
+bool FusorOrbitPropagator::keplerSegment(Vector3d& r, Vector3d& v, const double mu, Region& region, const double tau, double& used) const
+{
+    const double sqrtMu = std::sqrt(mu);
+    const double r0 = r.norm();
+    const double sigma0 = r.dot(v) / sqrtMu;
+    const double alpha = 2.0 / r0 - v.squaredNorm() / mu;
+
+    auto timeOf = [&](const double chi)
+    {
+        const double z = alpha * chi * chi;
+        return (sigma0 * chi * chi * stumpffC(z) + (1.0 - alpha * r0) * chi * chi * chi * stumpffS(z) + r0 * chi) / sqrtMu;
+    };
+
+    auto radiusOf = [&](const double chi)
+    {
+        const double z = alpha * chi * chi;
+        return chi * chi * stumpffC(z) + sigma0 * chi * (1.0 - z * stumpffS(z)) + r0 * (1.0 - z * stumpffC(z));
+    };
+
+    // full revolutions of a bound orbit are taken out first, chi advances by 2 pi / sqrt(alpha) per period
+    double target = tau;
+    double chiRevolutions = 0.0;
+    if (alpha > 0.0)
+    {
+        const double period = 2.0 * constants::pi / (sqrtMu * alpha * std::sqrt(alpha));
+        const double revolutions = std::floor(tau / period);
+        target -= revolutions * period;
+        chiRevolutions = revolutions * 2.0 * constants::pi / std::sqrt(alpha);
+    }
+
+    // universal Kepler equation, t(chi) is monotonic with dt/dchi = r / sqrt(mu), Newton safeguarded by bisection
+    double lo = 0.0;
+    double hi = sqrtMu * target / r0;
+    while (timeOf(hi) < target)
+    {
+        lo = hi;
+        hi *= 2.0;
+        if (!std::isfinite(hi))
+        {
+            return false;
+        }
+    }
+
+    double chi = 0.5 * (lo + hi);
+    bool converged = false;
+    for (int it = 0; it < maxNewtonIterations; ++it)
+    {
+        const double residual = timeOf(chi) - target;
+        if (residual > 0.0)
+        {
+            hi = chi;
+        }
+        else
+        {
+            lo = chi;
+        }
+
+        double next = chi - residual * sqrtMu / radiusOf(chi);
+        if (!(next > lo && next < hi))
+        {
+            next = 0.5 * (lo + hi);
+        }
+
+        const double delta = next - chi;
+        chi = next;
+        if (std::abs(delta) <= 1e-13 * chi || hi - lo <= 1e-13 * hi)
+        {
+            converged = true;
+            break;
+        }
+    }
+    if (!converged)
+    {
+        return false;
+    }
+    chi += chiRevolutions;
+
+    const double ri = m_field.getInnerGridRadius();
+    const double ro = m_field.getOuterGridRadius();
+    const double chiInner = crossingAnomaly(r0, sigma0, alpha, ri, false);
+    const double chiOuter = crossingAnomaly(r0, sigma0, alpha, ro, true);
+
+    double crossingRadius = 0.0;
+    Region next = region;
+    if (chiInner > 0.0 && chiInner <= chi && (chiOuter <= 0.0 || chiInner <= chiOuter))
+    {
+        chi = chiInner;
+        crossingRadius = ri;
+        next = Region::INSIDE_CATHODE;
+    }
+    else if (chiOuter > 0.0 && chiOuter <= chi)
+    {
+        chi = chiOuter;
+        crossingRadius = ro;
+        next = Region::OUTSIDE_ANODE;
+    }
+
+    used = next == region ? tau : std::min(timeOf(chi), tau);
+
+    const double z = alpha * chi * chi;
+    const double s = stumpffS(z);
+    const double c = stumpffC(z);
+    const double f = 1.0 - chi * chi / r0 * c;
+    const double g = used - chi * chi * chi * s / sqrtMu;
+
+    const Vector3d r1 = f * r + g * v;
+    const double r1Norm = r1.norm();
+    const double fDot = sqrtMu / (r1Norm * r0) * (z * s - 1.0) * chi;
+    const double gDot = 1.0 - chi * chi / r1Norm * c;
+
+    v = fDot * r + gDot * v;
+    r = r1;
+
+    if (next != region)
+    {
+        r *= crossingRadius / r1Norm;
+        region = next;
+    }
+    return true;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "FarnsworthFusorFieldModel.h"
+#include "Vector3dSimple.h"
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Exact propagator for the fusor field, Kepler conics between the grids and straight lines elsewhere. \class FusorOrbitPropagator
+    class FusorOrbitPropagator
+    {
+    public:
+        /**
+         * @brief Constructor for FusorOrbitPropagator.
+         * @param field The fusor field model, must outlive the propagator.
+         */
+        explicit FusorOrbitPropagator(const FarnsworthFusorFieldModel& field);
+
+        /**
+         * @brief Advance a particle exactly by dt.
+         * @param position Position, updated in place.
+         * @param velocity Velocity, updated in place.
+         * @param chargeOverMass Charge to mass ratio of the particle.
+         * @param dt Time step.
+         * @return False if the orbit cannot be handled (repulsive field), position and velocity are then unchanged.
+         */
+        bool propagate(Vector3d& position, Vector3d& velocity, double chargeOverMass, double dt) const;
+
+    private:
+        /// @brief Radial regions of the fusor. \enum Region
+        enum class Region
+        {
+            INSIDE_CATHODE,
+            BETWEEN_GRIDS,
+            OUTSIDE_ANODE
+        };
+
+        /**
+         * @brief Stumpff function S(z).
+         * @param z The argument.
+         * @return S(z).
+         */
+        static double stumpffS(double z);
+
+        /**
+         * @brief Stumpff function C(z).
+         * @param z The argument.
+         * @return C(z).
+         */
+        static double stumpffC(double z);
+
+        /**
+         * @brief Straight flight in a field-free region up to the next grid crossing or the end of the segment.
+         * @param r Position, updated in place.
+         * @param v Velocity.
+         * @param region Current region, updated on a crossing.
+         * @param tau Remaining time.
+         * @return The time used.
+         */
+        double driftSegment(Vector3d& r, const Vector3d& v, Region& region, double tau) const;
+
+        /**
+         * @brief Kepler flight between the grids up to the next grid crossing or the end of the segment.
+         * @param r Position, updated in place.
+         * @param v Velocity, updated in place.
+         * @param mu Gravitational parameter equivalent of the central field.
+         * @param region Current region, updated on a crossing.
+         * @param tau Remaining time.
+         * @param used The time used.
+         * @return False if the universal Kepler equation did not converge.
+         */
+        bool keplerSegment(Vector3d& r, Vector3d& v, double mu, Region& region, double tau, double& used) const;
+
+        /**
+         * @brief Smallest positive universal anomaly at which the orbit crosses a radius in the given direction.
+         * @param r0 Start radius.
+         * @param sigma0 r0 . v0 / sqrt(mu).
+         * @param alpha Reciprocal semi-major axis.
+         * @param radius The radius to cross.
+         * @param outward True for an outward crossing, false for an inward crossing.
+         * @return The universal anomaly, or a negative value if the radius is not crossed.
+         */
+        static double crossingAnomaly(double r0, double sigma0, double alpha, double radius, bool outward);
+
+        /// @brief Upper bound of region changes handled within one step.
+        static constexpr int maxSegments = 32;
+
+        const FarnsworthFusorFieldModel& m_field;
+    };
+}
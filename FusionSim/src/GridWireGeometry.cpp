@@ -0,0 +1,252 @@
+#include "GridWireGeometry.h"
+#include "PhysicalConstants.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fusion;
+
+namespace
+{
+    inline double axisOf(const Vector3d& v, const int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    inline Vector3d componentMin(const Vector3d& a, const Vector3d& b)
+    {
+        return Vector3d(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+    }
+
+    inline Vector3d componentMax(const Vector3d& a, const Vector3d& b)
+    {
+        return Vector3d(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+    }
+}
+
+GridWireGeometry::GridWireGeometry(const double radius, const double wireDiameter, const int wireCount, const int segmentsPerRing)
+    : m_radius(radius)
+    , m_wireRadius(0.5 * wireDiameter)
+    , m_ringCount(std::max((wireCount + 1) / 2, 1))
+{
+    const int segments = std::max(segmentsPerRing, 3);
+    const double goldenAngle = constants::pi * (3.0 - std::sqrt(5.0));
+
+    // ring normals spread over the upper hemisphere on a Fibonacci spiral, so the great circles cross evenly
+    for (int k = 0; k < m_ringCount; ++k)
+    {
+        const double nz = 1.0 - (k + 0.5) / m_ringCount;
+        const double ns = std::sqrt(std::max(0.0, 1.0 - nz * nz));
+        const double phi = k * goldenAngle;
+        const Vector3d normal(ns * std::cos(phi), ns * std::sin(phi), nz);
+
+        const Vector3d helper = std::abs(normal.z) < 0.9 ? Vector3d(0.0, 0.0, 1.0) : Vector3d(1.0, 0.0, 0.0);
+        const Vector3d u = normal.cross(helper).normalized();
+        const Vector3d w = normal.cross(u);
+
+        for (int s = 0; s < segments; ++s)
+        {
+            const double a0 = 2.0 * constants::pi * s / segments;
+            const double a1 = 2.0 * constants::pi * (s + 1) / segments;
+            m_segments.push_back({
+                (u * std::cos(a0) + w * std::sin(a0)) * m_radius,
+                (u * std::cos(a1) + w * std::sin(a1)) * m_radius });
+        }
+    }
+
+    m_nodes.reserve(2 * m_segments.size() / leafSize + 1);
+    buildNode(0, static_cast<uint32_t>(m_segments.size()));
+}
+
+uint32_t GridWireGeometry::buildNode(const uint32_t first, const uint32_t count)
+{
+    const auto index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.push_back({});
+
+    Vector3d lo = componentMin(m_segments[first].a, m_segments[first].b);
+    Vector3d hi = componentMax(m_segments[first].a, m_segments[first].b);
+    for (uint32_t s = first + 1; s < first + count; ++s)
+    {
+        lo = componentMin(lo, componentMin(m_segments[s].a, m_segments[s].b));
+        hi = componentMax(hi, componentMax(m_segments[s].a, m_segments[s].b));
+    }
+
+    const Vector3d pad(m_wireRadius, m_wireRadius, m_wireRadius);
+    m_nodes[index].lo = lo - pad;
+    m_nodes[index].hi = hi + pad;
+
+    if (count <= leafSize)
+    {
+        m_nodes[index].leftOrFirst = first;
+        m_nodes[index].count = count;
+        return index;
+    }
+
+    // median split of the segment midpoints along the longest box axis
+    const Vector3d extent = hi - lo;
+    const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const uint32_t half = count / 2;
+    std::nth_element(m_segments.begin() + first, m_segments.begin() + first + half, m_segments.begin() + first + count,
+        [axis](const Segment& l, const Segment& r)
+        {
+            return axisOf(l.a + l.b, axis) < axisOf(r.a + r.b, axis);
+        });
+
+    buildNode(first, half);
+    const uint32_t right = buildNode(first + half, count - half);
+    // the left child directly follows its parent, only the right child is stored
+    m_nodes[index].leftOrFirst = right;
+    m_nodes[index].count = 0;
+    return index;
+}
+
+bool GridWireGeometry::overlapsBox(const Node& node, const Vector3d& from, const Vector3d& delta)
+{
+    double tMin = 0.0;
+    double tMax = 1.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const double o = axisOf(from, axis);
+        const double d = axisOf(delta, axis);
+        const double lo = axisOf(node.lo, axis);
+        const double hi = axisOf(node.hi, axis);
+        if (std::abs(d) < 1e-300)
+        {
+            if (o < lo || o > hi)
+            {
+                return false;
+            }
+            continue;
+        }
+
+        double t0 = (lo - o) / d;
+        double t1 = (hi - o) / d;
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double GridWireGeometry::segmentDistanceSquared(const Vector3d& p0, const Vector3d& p1, const Vector3d& q0, const Vector3d& q1)
+{
+    const Vector3d d1 = p1 - p0;
+    const Vector3d d2 = q1 - q0;
+    const Vector3d r = p0 - q0;
+    const double a = d1.squaredNorm();
+    const double e = d2.squaredNorm();
+    const double f = d2.dot(r);
+
+    double s = 0.0;
+    double t = 0.0;
+    if (a <= 1e-300 && e <= 1e-300)
+    {
+        return r.squaredNorm();
+    }
+    if (a <= 1e-300)
+    {
+        t = std::clamp(f / e, 0.0, 1.0);
+    }
+    else
+    {
+        const double c = d1.dot(r);
+        if (e <= 1e-300)
+        {
+            s = std::clamp(-c / a, 0.0, 1.0);
+        }
+        else
+        {
+            const double b = d1.dot(d2);
+            const double denom = a * e - b * b;
+            s = denom > 0.0 ? std::clamp((b * f - c * e) / denom, 0.0, 1.0) : 0.0;
+            t = (b * s + f) / e;
+            if (t < 0.0)
+            {
+                t = 0.0;
+                s = std::clamp(-c / a, 0.0, 1.0);
+            }
+            else if (t > 1.0)
+            {
+                t = 1.0;
+                s = std::clamp((b - c) / a, 0.0, 1.0);
+            }
+        }
+    }
+
+    return ((p0 + d1 * s) - (q0 + d2 * t)).squaredNorm();
+}
+
+bool GridWireGeometry::intersects(const Vector3d& from, const Vector3d& to) const
+{
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+
+    const Vector3d delta = to - from;
+    const double reach2 = m_wireRadius * m_wireRadius;
+
+    // the wires lie on the shell |r| = radius, paths that stay clear of it are rejected without the tree
+    const double inner = m_radius - m_wireRadius;
+    const double outer = m_radius + m_wireRadius;
+    if (std::max(from.squaredNorm(), to.squaredNorm()) < inner * inner)
+    {
+        return false;
+    }
+    const double len2 = delta.squaredNorm();
+    const double closest = len2 > 0.0 ? std::clamp(-from.dot(delta) / len2, 0.0, 1.0) : 0.0;
+    if ((from + delta * closest).squaredNorm() > outer * outer)
+    {
+        return false;
+    }
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = m_nodes[stack[--top]];
+        if (!overlapsBox(node, from, delta))
+        {
+            continue;
+        }
+
+        if (node.count > 0)
+        {
+            for (uint32_t s = node.leftOrFirst; s < node.leftOrFirst + node.count; ++s)
+            {
+                if (segmentDistanceSquared(from, to, m_segments[s].a, m_segments[s].b) <= reach2)
+                {
+                    return true;
+                }
+            }
+            continue;
+        }
+
+        const auto self = static_cast<uint32_t>(&node - m_nodes.data());
+        stack[top++] = node.leftOrFirst;
+        stack[top++] = self + 1;
+    }
+    return false;
+}
+
+size_t GridWireGeometry::getSegmentCount() const
+{
+    return m_segments.size();
+}
+
+int GridWireGeometry::getRingCount() const
+{
+    return m_ringCount;
+}
+
+double GridWireGeometry::getRadius() const
+{
+    return m_radius;
+}
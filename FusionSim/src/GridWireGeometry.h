@@ -0,0 +1,105 @@
+#pragma once
+#include "Vector3dSimple.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Wire-resolved Rosenstiehl spherical grid, capsule segments in a bounding volume hierarchy. \class GridWireGeometry
+    class GridWireGeometry
+    {
+    public:
+        /// @brief Default number of straight segments per great circle.
+        static constexpr int defaultSegmentsPerRing = 64;
+
+        /**
+         * @brief Constructor for GridWireGeometry.
+         * @param radius Grid radius in meters.
+         * @param wireDiameter Wire diameter in meters.
+         * @param wireCount Number of half-circle wires, as in FarnsworthFusorFieldModel. Pairs form one great circle.
+         * @param segmentsPerRing Number of straight segments per great circle.
+         */
+        GridWireGeometry(double radius, double wireDiameter, int wireCount, int segmentsPerRing = defaultSegmentsPerRing);
+
+        /**
+         * @brief Test a straight path against the wires.
+         * @param from Start of the path.
+         * @param to End of the path.
+         * @return True if the path touches a wire.
+         */
+        [[nodiscard]] bool intersects(const Vector3d& from, const Vector3d& to) const;
+
+        /**
+         * @brief Getter for the number of wire segments.
+         * @return The number of segments.
+         */
+        [[nodiscard]] size_t getSegmentCount() const;
+
+        /**
+         * @brief Getter for the number of great circles.
+         * @return The number of rings.
+         */
+        [[nodiscard]] int getRingCount() const;
+
+        /**
+         * @brief Getter for the grid radius.
+         * @return The radius in meters.
+         */
+        [[nodiscard]] double getRadius() const;
+
+    private:
+        /// @brief Straight wire piece. \struct Segment
+        struct Segment
+        {
+            Vector3d a;
+            Vector3d b;
+        };
+
+        /// @brief BVH node, a leaf if count > 0. \struct Node
+        struct Node
+        {
+            Vector3d lo;
+            Vector3d hi;
+            uint32_t leftOrFirst;
+            uint32_t count;
+        };
+
+        /**
+         * @brief Build the subtree over the segments [first, first + count).
+         * @param first First segment of the subtree.
+         * @param count Number of segments in the subtree.
+         * @return Index of the subtree root.
+         */
+        uint32_t buildNode(uint32_t first, uint32_t count);
+
+        /**
+         * @brief Slab test of a path against a node box.
+         * @param node The node.
+         * @param from Start of the path.
+         * @param delta Path vector.
+         * @return True if the path overlaps the box.
+         */
+        static bool overlapsBox(const Node& node, const Vector3d& from, const Vector3d& delta);
+
+        /**
+         * @brief Squared distance between two segments.
+         * @param p0 Start of the first segment.
+         * @param p1 End of the first segment.
+         * @param q0 Start of the second segment.
+         * @param q1 End of the second segment.
+         * @return The squared closest distance.
+         */
+        static double segmentDistanceSquared(const Vector3d& p0, const Vector3d& p1, const Vector3d& q0, const Vector3d& q1);
+
+        /// @brief Maximum number of segments in a leaf.
+        static constexpr uint32_t leafSize = 4;
+
+        double m_radius;
+        double m_wireRadius;
+        int m_ringCount;
+        std::vector<Segment> m_segments;
+        std::vector<Node> m_nodes;
+    };
+}
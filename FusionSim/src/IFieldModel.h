@@ -20,5 +20,38 @@ namespace fusion
          * @return The electric field vector at the given position.
          */
         [[nodiscard]] virtual Vector3d getFieldAt(const Vector3d& position) const = 0;
+
+        /**
+         * @brief Getter for the electric field at a given position and time.
+         * @param position The position where the field is queried.
+         * @param time The simulation time in seconds.
+         * @return The electric field vector at the given position and time.
+         */
+        [[nodiscard]] virtual Vector3d getFieldAt(const Vector3d& position, double /*time*/) const
+        {
+            return getFieldAt(position);
+        }
+
+        /**
+         * @brief Prepare the field for the next time step, called once per step before the push.
+         * Time-dependent models evaluate their drive here so getFieldAt(position) stays time-free.
+         * @param time The simulation time at the start of the step in seconds.
+         * @param dt The time step in seconds.
+         */
+        virtual void prepareStep(double /*time*/, double /*dt*/)
+        {
+        }
+
+        /**
+         * @brief Time a straight flight from a position stays inside a field-free region of the model.
+         * @param position The start position.
+         * @param velocity The velocity of the flight.
+         * @param maxTime The longest time of interest in seconds.
+         * @return 0 if the position is not field-free, otherwise the time until the region is left, at most maxTime.
+         */
+        [[nodiscard]] virtual double getFieldFreeTime(const Vector3d& /*position*/, const Vector3d& /*velocity*/, double /*maxTime*/) const
+        {
+            return 0.0;
+        }
     };
 }
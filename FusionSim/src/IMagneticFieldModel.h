@@ -19,5 +19,14 @@ namespace fusion
          * @return The magnetic field vector at the given position.
          */
         [[nodiscard]] virtual Vector3d getFieldAt(const Vector3d& position) const = 0;
+
+        /**
+         * @brief Check if the field vanishes everywhere.
+         * @return True if the field is zero everywhere.
+         */
+        [[nodiscard]] virtual bool isZero() const
+        {
+            return false;
+        }
     };
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 #include "Vector3dSimple.h"
+#include "FieldContext.h"
+#include "Species.h"
 
 /// @brief FusionSim - a simulator for FFR \namespace  fusion
 namespace fusion
@@ -17,9 +19,10 @@ namespace fusion
 
         /**
          * @brief Propagate the particle for a time step dt.
+         * @param fields The fields of the simulation.
          * @param dt Time step for propagation.
          */
-        virtual void propagate(double dt) = 0;
+        virtual void propagate(const FieldContext& fields, double dt) = 0;
 
         /**
          * @brief Getter for the current position.
@@ -33,6 +36,12 @@ namespace fusion
          */
         [[nodiscard]] virtual Vector3d getVelocity() const = 0;
 
+        /**
+         * @brief Setter for the position.
+         * @param p New position as Vector3d.
+         */
+        virtual void setPosition(const Vector3d& p) = 0;
+
         /**
          * @brief Setter for the velocity.
          * @param v New velocity as Vector3d.
@@ -51,6 +60,12 @@ namespace fusion
          */
         [[nodiscard]] virtual double getCharge() const = 0;
 
+        /**
+         * @brief Getter for the particle species.
+         * @return The species, mass and charge follow from the SpeciesTable.
+         */
+        [[nodiscard]] virtual Species getSpecies() const = 0;
+
         /**
          * @brief Clone the particle model.
          * @return A unique pointer to the cloned particle model.
@@ -24,22 +24,53 @@ namespace fusion
          */
         [[nodiscard]] virtual double getCrossSection(double energy_keV) const = 0;
 
+        /**
+         * @brief Getter for the cross section of a given species pair.
+         * @param a Species of the first particle.
+         * @param b Species of the second particle.
+         * @param energy_keV The centre-of-mass energy in keV.
+         * @return The cross section, 0 if the pair cannot react. Single-channel models only exclude electrons.
+         */
+        [[nodiscard]] virtual double getPairCrossSection(Species a, Species b, double energy_keV) const
+        {
+            if (a == Species::ELECTRON || b == Species::ELECTRON)
+            {
+                return 0.0;
+            }
+            return getCrossSection(energy_keV);
+        }
+
+        /**
+         * @brief Getter for the lowest centre-of-mass energy at which a pair is worth testing.
+         * @return The threshold energy in keV, 0 to test every pair.
+         */
+        [[nodiscard]] virtual double getThresholdEnergy() const
+        {
+            return 0.0;
+        }
+
         /**
          * @brief Method to start reaction.
          * @param reactants The particle model.
-         * @param fieldModel The field model.
-         * @param magFieldModel The magnetic field model.
          * @return A vector of unqPtrs with the react.
          */
         virtual std::vector<std::unique_ptr<IParticleModel>> react(
-            const std::vector<std::unique_ptr<IParticleModel>>& reactants,
-            std::shared_ptr<const IFieldModel> fieldModel,
-            std::shared_ptr<const IMagneticFieldModel> magFieldModel) = 0;
+            const std::vector<std::unique_ptr<IParticleModel>>& reactants) = 0;
 
         /**
          * @brief Getter for the name of the reaction model.
          * @return The name as string.
          */
         [[nodiscard]] virtual std::string getName() const = 0;
+
+        /**
+         * @brief Getter for the branch a set of products belongs to.
+         * @param products The products returned by react().
+         * @return The branch index, 0 for single-branch reactions.
+         */
+        [[nodiscard]] virtual int getBranch(const std::vector<std::unique_ptr<IParticleModel>>& /*products*/) const
+        {
+            return 0;
+        }
     };
 }
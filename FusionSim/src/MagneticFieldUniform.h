@@ -28,6 +28,15 @@ namespace fusion
             return m_B;
         }
 
+        /**
+         * @brief Check if the field vanishes everywhere.
+         * @return True if the uniform field vector is zero.
+         */
+        [[nodiscard]] bool isZero() const override
+        {
+            return m_B.squaredNorm() == 0.0;
+        }
+
     private:
         Vector3d m_B;
     };
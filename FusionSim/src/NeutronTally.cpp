@@ -0,0 +1,141 @@
+#include "NeutronTally.h"
+#include "PhysicalConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using namespace fusion;
+
+NeutronTally::NeutronTally(const double chamberRadius, const double detectorRadius, const size_t sampleEvery)
+    : m_chamberRadius(chamberRadius)
+    , m_detectorRadius(std::max(detectorRadius, chamberRadius))
+    , m_sampleEvery(sampleEvery)
+    , m_timeWindow(1.0)
+    , m_flightWindow(0.0)
+    , m_count(0.0)
+    , m_seen(0)
+    , m_energy(energyBins, 0.0)
+    , m_cosTheta(angleBins, 0.0)
+    , m_phi(angleBins, 0.0)
+    , m_emissionTime(timeBins, 0.0)
+    , m_flightTime(flightBins, 0.0)
+{
+    // the window covers a 1 MeV neutron crossing the whole detector sphere
+    const double referenceSpeed = std::sqrt(2.0 * constants::MeVtoJoule / constants::massNeutron);
+    m_flightWindow = 2.0 * m_detectorRadius / referenceSpeed;
+}
+
+void NeutronTally::setTimeWindow(const double tMax)
+{
+    m_timeWindow = tMax;
+}
+
+double NeutronTally::distanceToSphereExit(const Vector3d& position, const Vector3d& direction, const double radius)
+{
+    const double c = position.squaredNorm() - radius * radius;
+    if (c >= 0.0)
+    {
+        return 0.0;
+    }
+    const double b = position.dot(direction);
+    return -b + std::sqrt(b * b - c);
+}
+
+void NeutronTally::fill(std::vector<double>& hist, const double low, const double high, const double value, const double weight)
+{
+    const double scaled = (value - low) / (high - low) * static_cast<double>(hist.size());
+    const auto bin = static_cast<long long>(std::floor(scaled));
+    const auto clamped = std::min<long long>(std::max<long long>(bin, 0), static_cast<long long>(hist.size()) - 1);
+    hist[static_cast<size_t>(clamped)] += weight;
+}
+
+void NeutronTally::record(const Vector3d& position, const Vector3d& velocity, const double mass, const double birthTime, const double weight)
+{
+    const double speed = velocity.norm();
+    if (speed <= 0.0)
+    {
+        return;
+    }
+
+    const Vector3d direction = velocity / speed;
+    const double pathChamber = distanceToSphereExit(position, direction, m_chamberRadius);
+    const Vector3d exitPosition = position + direction * pathChamber;
+    const double pathDetector = pathChamber + distanceToSphereExit(exitPosition, direction, m_detectorRadius);
+    const Vector3d detectorPosition = position + direction * pathDetector;
+
+    const double flightTime = pathDetector / speed;
+    const double energy_MeV = 0.5 * mass * speed * speed / constants::MeVtoJoule;
+    const double radius = detectorPosition.norm();
+    const double cosTheta = radius > 0.0 ? detectorPosition.z / radius : 1.0;
+    const double phi = std::atan2(detectorPosition.y, detectorPosition.x);
+
+    m_count += weight;
+    fill(m_energy, 0.0, energyMax_MeV, energy_MeV, weight);
+    fill(m_cosTheta, -1.0, 1.0, cosTheta, weight);
+    fill(m_phi, -constants::pi, constants::pi, phi, weight);
+    fill(m_emissionTime, 0.0, m_timeWindow, birthTime, weight);
+    fill(m_flightTime, 0.0, m_flightWindow, flightTime, weight);
+
+    if (m_sampleEvery > 0 && m_seen % m_sampleEvery == 0)
+    {
+        m_samples.push_back({ exitPosition, direction, energy_MeV, birthTime + flightTime });
+    }
+    ++m_seen;
+}
+
+double NeutronTally::getCount() const
+{
+    return m_count;
+}
+
+double NeutronTally::getProductionRate() const
+{
+    return m_timeWindow > 0.0 ? m_count / m_timeWindow : 0.0;
+}
+
+double NeutronTally::getDetectorFlux() const
+{
+    // NPR = flux * 4 pi d^2, with d in cm as in npr.py
+    const double distance_cm = m_detectorRadius * 100.0;
+    return getProductionRate() / (4.0 * constants::pi * distance_cm * distance_cm);
+}
+
+const std::vector<NeutronTally::Sample>& NeutronTally::getSamples() const
+{
+    return m_samples;
+}
+
+void NeutronTally::writeHistograms(const std::string& filename) const
+{
+    std::ofstream out(filename);
+    out << "histogram,low,high,counts" << std::endl;
+
+    auto writeHist = [&out](const char* name, const std::vector<double>& hist, const double low, const double high)
+    {
+        const double width = (high - low) / static_cast<double>(hist.size());
+        for (size_t b = 0; b < hist.size(); ++b)
+        {
+            out << name << "," << low + b * width << "," << low + (b + 1) * width << "," << hist[b] << "\n";
+        }
+    };
+
+    writeHist("energy_MeV", m_energy, 0.0, energyMax_MeV);
+    writeHist("cos_theta", m_cosTheta, -1.0, 1.0);
+    writeHist("phi_rad", m_phi, -constants::pi, constants::pi);
+    writeHist("emission_time_s", m_emissionTime, 0.0, m_timeWindow);
+    writeHist("flight_time_s", m_flightTime, 0.0, m_flightWindow);
+    out.close();
+}
+
+void NeutronTally::writeSamples(const std::string& filename) const
+{
+    std::ofstream out(filename);
+    out << "x,y,z,dx,dy,dz,energy_MeV,arrival_time" << std::endl;
+    for (const auto& s : m_samples)
+    {
+        out << s.exitPosition.x << "," << s.exitPosition.y << "," << s.exitPosition.z << ","
+            << s.direction.x << "," << s.direction.y << "," << s.direction.z << ","
+            << s.energy_MeV << "," << s.arrivalTime << "\n";
+    }
+    out.close();
+}
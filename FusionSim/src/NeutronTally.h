@@ -0,0 +1,123 @@
+#pragma once
+#include "Vector3dSimple.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Tallies neutral reaction products on a spherical detector without pushing them. \class NeutronTally
+    class NeutronTally
+    {
+    public:
+        /// @brief A single decimated neutron kept for plotting. \struct Sample
+        struct Sample
+        {
+            Vector3d exitPosition;
+            Vector3d direction;
+            double energy_MeV;
+            double arrivalTime;
+        };
+
+        /**
+         * @brief Constructor for NeutronTally.
+         * @param chamberRadius Radius of the vacuum chamber in meters.
+         * @param detectorRadius Distance of the detector sphere from the centre in meters.
+         * @param sampleEvery Keep every n-th neutron as a sample for plotting (0 disables sampling).
+         */
+        NeutronTally(double chamberRadius, double detectorRadius, size_t sampleEvery = 100);
+
+        /**
+         * @brief Set the emission time window used for the emission rate histogram.
+         * @param tMax The simulated time in seconds.
+         */
+        void setTimeWindow(double tMax);
+
+        /**
+         * @brief Fly a neutral product analytically to the detector sphere and tally it.
+         * @param position Birth position.
+         * @param velocity Velocity.
+         * @param mass Particle mass.
+         * @param birthTime Simulation time of the reaction in seconds.
+         * @param weight Statistical weight of the product.
+         */
+        void record(const Vector3d& position, const Vector3d& velocity, double mass, double birthTime, double weight = 1.0);
+
+        /**
+         * @brief Getter for the weighted number of tallied neutrals.
+         * @return The number of neutrals that reached the detector sphere.
+         */
+        [[nodiscard]] double getCount() const;
+
+        /**
+         * @brief Getter for the neutron production rate over the time window.
+         * @return The production rate in neutrons per second.
+         */
+        [[nodiscard]] double getProductionRate() const;
+
+        /**
+         * @brief Getter for the flux through the detector sphere, as npr.py relates it to the NPR.
+         * @return The flux in neutrons per second and square centimetre.
+         */
+        [[nodiscard]] double getDetectorFlux() const;
+
+        /**
+         * @brief Getter for the decimated samples.
+         * @return The kept samples.
+         */
+        [[nodiscard]] const std::vector<Sample>& getSamples() const;
+
+        /**
+         * @brief Write the histograms as CSV (histogram,low,high,counts).
+         * @param filename The output filename.
+         */
+        void writeHistograms(const std::string& filename) const;
+
+        /**
+         * @brief Write the decimated samples as CSV.
+         * @param filename The output filename.
+         */
+        void writeSamples(const std::string& filename) const;
+
+    private:
+        /**
+         * @brief Distance along a ray from a point to the exit of a centred sphere.
+         * @param position The start point.
+         * @param direction The unit direction.
+         * @param radius The sphere radius.
+         * @return The path length to the sphere, 0 if the point is already outside.
+         */
+        static double distanceToSphereExit(const Vector3d& position, const Vector3d& direction, double radius);
+
+        /**
+         * @brief Add a weighted value into a histogram.
+         * @param hist The histogram.
+         * @param low Lower edge of the histogram range.
+         * @param high Upper edge of the histogram range.
+         * @param value The value to bin, clamped into the range.
+         * @param weight The weight to add.
+         */
+        static void fill(std::vector<double>& hist, double low, double high, double value, double weight);
+
+        static constexpr size_t energyBins = 160;
+        static constexpr double energyMax_MeV = 16.0;
+        static constexpr size_t angleBins = 36;
+        static constexpr size_t timeBins = 100;
+        static constexpr size_t flightBins = 100;
+
+        double m_chamberRadius;
+        double m_detectorRadius;
+        size_t m_sampleEvery;
+        double m_timeWindow;
+        double m_flightWindow;
+        double m_count;
+        size_t m_seen;
+        std::vector<double> m_energy;
+        std::vector<double> m_cosTheta;
+        std::vector<double> m_phi;
+        std::vector<double> m_emissionTime;
+        std::vector<double> m_flightTime;
+        std::vector<Sample> m_samples;
+    };
+}
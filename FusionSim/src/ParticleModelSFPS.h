@@ -1,8 +1,8 @@
 #pragma once
 #include "IParticleModel.h"
 #include "Vector3dSimple.h"
-#include "IFieldModel.h"
-#include "IMagneticFieldModel.h"
+#include "FieldContext.h"
+#include "Species.h"
 #include <cmath>
 #include <memory>
 
@@ -18,39 +18,38 @@ namespace fusion
          * @brief Constructor for ParticleModelSFPS.
          * @param pos Initial position.
          * @param vel Initial velocity.
-         * @param mass Particle mass.
-         * @param charge Particle charge.
-         * @param field Shared pointer to the electric field model.
-         * @param magfield Shared pointer to the magnetic field model.
+         * @param species Particle species, mass and charge come from the SpeciesTable.
          */
         ParticleModelSFPS(
             const Vector3d& pos,
             const Vector3d& vel,
-            const double mass,
-            const double charge,
-            std::shared_ptr<const IFieldModel> field,
-            std::shared_ptr<const IMagneticFieldModel> magfield)
+            const Species species)
             : position(pos)
             , velocity(vel)
-            , m_mass(mass)
-            , m_charge(charge)
-            , m_field(std::move(field))
-            , m_magfield(std::move(magfield))
+            , m_species(species)
         {
         }
 
         /**
-         * @brief Propagate the particle using 4th order Runge-Kutta method.
+         * @brief Propagate the particle using 4th order Runge-Kutta method, uncoupled species fly straight.
+         * @param fields The fields of the simulation.
          * @param dt Time step for propagation.
          */
-        void propagate(const double dt) override
+        void propagate(const FieldContext& fields, const double dt) override
         {
+            const SpeciesInfo& info = SpeciesTable::get(m_species);
+            if (!info.fieldCoupled)
+            {
+                position += velocity * dt;
+                return;
+            }
+
+            const double qm = info.chargeOverMass;
             auto rhs = [&](const Vector3d& r, const Vector3d& v) -> Vector3d
             {
-                const Vector3d E = m_field ? m_field->getFieldAt(r) : Vector3d(0, 0, 0);
-                const Vector3d B = m_magfield ? m_magfield->getFieldAt(r) : Vector3d(0, 0, 0);
-                const Vector3d F = m_charge * (E + v.cross(B));
-                return F / m_mass;
+                const Vector3d E = fields.electric ? fields.electric->getFieldAt(r) : Vector3d(0, 0, 0);
+                const Vector3d B = fields.magnetic ? fields.magnetic->getFieldAt(r) : Vector3d(0, 0, 0);
+                return qm * (E + v.cross(B));
             };
 
             const Vector3d k1v = rhs(position, velocity);
@@ -84,6 +83,15 @@ namespace fusion
             return velocity;
         }
 
+        /**
+         * @brief Setter for the position.
+         * @param p New position as Vector3d.
+         */
+        void setPosition(const Vector3d& p) override
+        {
+            position = p;
+        }
+
         /**
          * @brief Setter for the velocity.
          * @param v New velocity as Vector3d.
@@ -99,7 +107,7 @@ namespace fusion
          */
         [[nodiscard]] double getMass() const override
         {
-            return m_mass;
+            return SpeciesTable::get(m_species).mass;
         }
 
         /**
@@ -108,25 +116,16 @@ namespace fusion
          */
         [[nodiscard]] double getCharge() const override
         {
-            return m_charge;
-        }
-
-        /**
-         * @brief Getter for the electric field model.
-         * @return Shared pointer to the electric field model.
-         */
-        [[nodiscard]] std::shared_ptr<const IFieldModel> getFieldModel() const
-        {
-            return m_field;
+            return SpeciesTable::get(m_species).charge;
         }
 
         /**
-         * @brief Getter for the magnetic field model.
-         * @return Shared pointer to the magnetic field model.
+         * @brief Getter for the particle species.
+         * @return The species.
          */
-        [[nodiscard]] std::shared_ptr<const IMagneticFieldModel> getMagFieldModel() const
+        [[nodiscard]] Species getSpecies() const override
         {
-            return m_magfield;
+            return m_species;
         }
 
         /**
@@ -135,15 +134,12 @@ namespace fusion
          */
         [[nodiscard]] std::unique_ptr<IParticleModel> clone() const override
         {
-            return std::make_unique<ParticleModelSFPS>(position, velocity, m_mass, m_charge, m_field, m_magfield);
+            return std::make_unique<ParticleModelSFPS>(position, velocity, m_species);
         }
 
     private:
         Vector3d position;
         Vector3d velocity;
-        double m_mass;
-        double m_charge;
-        std::shared_ptr<const IFieldModel> m_field;
-        std::shared_ptr<const IMagneticFieldModel> m_magfield;
+        Species m_species;
     };
 }
\ No newline at end of file
@@ -42,6 +42,7 @@ namespace fusion
             constexpr double Q_T_p = 4.033;
             constexpr double E_Tritium = 1.01;
             constexpr double E_proton = 3.02;
+            constexpr double E_threshold = 1.0;
 
             constexpr double BG = 31.3970;
             constexpr double A1 = 5.3701e4;
@@ -49,6 +50,12 @@ namespace fusion
             constexpr double A3 = -1.2706e-1;
             constexpr double A4 = 2.9327e-5;
             constexpr double A5 = -2.5151e-9;
+
+            constexpr double A1_Tp = 5.5576e4;
+            constexpr double A2_Tp = 2.1054e2;
+            constexpr double A3_Tp = -3.2638e-2;
+            constexpr double A4_Tp = 1.4987e-6;
+            constexpr double A5_Tp = 1.8181e-10;
         }
 
         /// @brief Constants for the DT reaction. \namespace dt_reaction
@@ -57,6 +64,10 @@ namespace fusion
             constexpr double Q_value = 17.586;
             constexpr double E_He4 = 3.52;
             constexpr double E_neutron = 14.07;
+            constexpr double E_threshold = 0.5;
+
+            /// @brief Upper end of the Bosch-Hale fit below in keV, the cross section is held constant above.
+            constexpr double E_fitMax = 550.0;
 
             constexpr double BG = 34.3827;
             constexpr double A1 = 6.927e4;
@@ -64,6 +75,28 @@ namespace fusion
             constexpr double A3 = 2.050e6;
             constexpr double A4 = 5.2002e4;
             constexpr double A5 = 0.0;
+
+            constexpr double B1 = 6.38e1;
+            constexpr double B2 = -9.95e-1;
+            constexpr double B3 = 6.981e-5;
+            constexpr double B4 = 1.728e-4;
+        }
+
+        /// @brief Constants for the D-He3 reaction. \namespace dhe3_reaction
+        namespace dhe3_reaction
+        {
+            constexpr double Q_value = 18.353;
+            constexpr double E_He4 = 3.6;
+            constexpr double E_proton = 14.7;
+
+            constexpr double BG = 68.7508;
+            constexpr double A1 = 5.7501e6;
+            constexpr double A2 = 2.5226e3;
+            constexpr double A3 = 4.5566e1;
+            constexpr double A4 = 0.0;
+            constexpr double B1 = -3.1995e-3;
+            constexpr double B2 = -8.5530e-6;
+            constexpr double B3 = 5.9014e-8;
         }
     }
 }
@@ -39,17 +39,22 @@ namespace fusion
             return sigma_mb * constants::millibarn;
         }
 
+        /**
+         * @brief Getter for the threshold energy, the cross section below it is negligible.
+         * @return The threshold energy in keV.
+         */
+        double getThresholdEnergy() const override
+        {
+            return constants::dd_reaction::E_threshold;
+        }
+
         /**
          * @brief Method to start reaction.
          * @param reactants The particle model.
-         * @param fieldModel The field model.
-         * @param magFieldModel The magnetic field model.
          * @return A vector of unqPtrs with the react.
          */
         std::vector<std::unique_ptr<IParticleModel>> react(
-            const std::vector<std::unique_ptr<IParticleModel>>& reactants,
-            std::shared_ptr<const IFieldModel> fieldModel,
-            std::shared_ptr<const IMagneticFieldModel> magFieldModel) override
+            const std::vector<std::unique_ptr<IParticleModel>>& reactants) override
         {
             std::vector<std::unique_ptr<IParticleModel>> products;
             if (reactants.size() < 2)
@@ -81,9 +86,9 @@ namespace fusion
                 constexpr double he3Energy = constants::dd_reaction::E_He3 * constants::MeVtoJoule;
                 const double he3Speed = std::sqrt(2.0 * he3Energy / constants::massHe3);
 
-                products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir1 * neutronSpeed, constants::massNeutron, 0.0, nullptr, nullptr));
+                products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir1 * neutronSpeed, Species::NEUTRON));
 
-                products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir2 * he3Speed, constants::massHe3, 2.0 * constants::eCharge, fieldModel, magFieldModel));
+                products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir2 * he3Speed, Species::HELIUM3));
             }
             else
             {
@@ -93,13 +98,9 @@ namespace fusion
                 constexpr double tritiumEnergy = constants::dd_reaction::E_Tritium * constants::MeVtoJoule;
                 const double tritiumSpeed = std::sqrt(2.0 * tritiumEnergy / constants::massTritium);
 
-                products.push_back(std::make_unique<ParticleModelSFPS>(
-                    pos, dir1 * protonSpeed, constants::massProton,
-                    constants::eCharge, fieldModel, magFieldModel));
+                products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir1 * protonSpeed, Species::PROTON));
 
-                products.push_back(std::make_unique<ParticleModelSFPS>(
-                    pos, dir2 * tritiumSpeed, constants::massTritium,
-                    constants::eCharge, fieldModel, magFieldModel));
+                products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir2 * tritiumSpeed, Species::TRITIUM));
             }
 
             return products;
@@ -114,6 +115,23 @@ namespace fusion
             return "Deuterium-Deuterium";
         }
 
+        /**
+         * @brief Getter for the branch of a set of products.
+         * @param products The products returned by react().
+         * @return 0 for the He3 + n branch, 1 for the T + p branch.
+         */
+        int getBranch(const std::vector<std::unique_ptr<IParticleModel>>& products) const override
+        {
+            for (const auto& p : products)
+            {
+                if (p->getSpecies() == Species::NEUTRON)
+                {
+                    return 0;
+                }
+            }
+            return 1;
+        }
+
     private:
         mutable std::mt19937 m_rng{std::random_device{}()};
     };
@@ -2,6 +2,7 @@
 #include "IReactionModel.h"
 #include "ParticleModelSFPS.h"
 #include "PhysicalConstants.h"
+#include "ReactionModelMultiChannel.h"
 #include <random>
 #include <cmath>
 
@@ -14,38 +15,31 @@ namespace fusion
     public:
 
         /**
-         * @brief Getter for the cross section.
+         * @brief Getter for the cross section, the same Bosch-Hale evaluation as the D-T channel of the mixed-fuel model.
          * @param energy_keV The energy in keV.
          * @return A double represting the cross section.
          */
         double getCrossSection(const double energy_keV) const override
         {
-            if (energy_keV <= 0.0)
-            {
-                return 0.0;
-            }
-
-            using namespace constants::dt_reaction;
-
-            const double E = energy_keV;
-            const double denom = 1.0 + E * (A2 + E * (A4 + E * A5));
-            const double S = A1 + (A3 * E) / denom;
-            const double sigma_mb = S / (E * std::exp(BG / std::sqrt(E)));
+            return ReactionModelMultiChannel::boschHale(ReactionModelMultiChannel::DT, energy_keV);
+        }
 
-            return sigma_mb * constants::millibarn;
+        /**
+         * @brief Getter for the threshold energy, the cross section below it is negligible.
+         * @return The threshold energy in keV.
+         */
+        double getThresholdEnergy() const override
+        {
+            return constants::dt_reaction::E_threshold;
         }
 
         /**
          * @brief Method to start reaction.
          * @param reactants The particle model.
-         * @param fieldModel The field model.
-         * @param magFieldModel The magnetic field model.
          * @return A vector of unqPtrs with the react.
          */
         std::vector<std::unique_ptr<IParticleModel>> react(
-            const std::vector<std::unique_ptr<IParticleModel>>& reactants,
-            std::shared_ptr<const IFieldModel> fieldModel,
-            std::shared_ptr<const IMagneticFieldModel> magFieldModel) override
+            const std::vector<std::unique_ptr<IParticleModel>>& reactants) override
         {
             std::vector<std::unique_ptr<IParticleModel>> products;
             if (reactants.size() < 2)
@@ -72,8 +66,8 @@ namespace fusion
             constexpr double he4Energy = constants::dt_reaction::E_He4 * constants::MeVtoJoule;
             const double he4Speed = std::sqrt(2.0 * he4Energy / constants::massHe4);
 
-            products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir1 * neutronSpeed, constants::massNeutron, 0.0, nullptr, nullptr));
-            products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir2 * he4Speed, constants::massHe4, 2.0 * constants::eCharge, fieldModel, magFieldModel));
+            products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir1 * neutronSpeed, Species::NEUTRON));
+            products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir2 * he4Speed, Species::HELIUM4));
 
             return products;
         }
@@ -0,0 +1,250 @@
+#include "ReactionModelMultiChannel.h"
+#include "ParticleModelSFPS.h"
+#include "PhysicalConstants.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fusion;
+
+ReactionModelMultiChannel::ReactionModelMultiChannel()
+    : m_logSigma(tableSize * CHANNEL_COUNT)
+    , m_logMinEnergy(std::log(minEnergy_keV))
+    , m_invLogStep((tableSize - 1) / (std::log(maxEnergy_keV) - std::log(minEnergy_keV)))
+    , m_dispatch{}
+{
+    // one row per energy with all channels side by side, so a pair reads a single cache line per lookup
+    for (size_t k = 0; k < tableSize; ++k)
+    {
+        const double E = std::exp(m_logMinEnergy + k / m_invLogStep);
+        for (int c = 0; c < CHANNEL_COUNT; ++c)
+        {
+            const double sigma = boschHale(static_cast<Channel>(c), E);
+            m_logSigma[k * CHANNEL_COUNT + c] = std::log(std::max(sigma, 1e-300));
+        }
+    }
+
+    const ChannelInfo* channels = channelTable();
+    for (int c = 0; c < CHANNEL_COUNT; ++c)
+    {
+        const auto a = static_cast<size_t>(channels[c].reactantA);
+        const auto b = static_cast<size_t>(channels[c].reactantB);
+        PairChannels& forward = m_dispatch[a][b];
+        forward.channels[forward.count++] = static_cast<uint8_t>(c);
+        if (a != b)
+        {
+            PairChannels& backward = m_dispatch[b][a];
+            backward.channels[backward.count++] = static_cast<uint8_t>(c);
+        }
+    }
+}
+
+const ReactionModelMultiChannel::ChannelInfo* ReactionModelMultiChannel::channelTable()
+{
+    using namespace constants;
+    static constexpr ChannelInfo entries[] = {
+        { "D(d,n)He3", Species::DEUTERIUM, Species::DEUTERIUM, Species::NEUTRON, dd_reaction::E_neutron_He3, Species::HELIUM3, dd_reaction::E_He3 },
+        { "D(d,p)T", Species::DEUTERIUM, Species::DEUTERIUM, Species::PROTON, dd_reaction::E_proton, Species::TRITIUM, dd_reaction::E_Tritium },
+        { "T(d,n)He4", Species::DEUTERIUM, Species::TRITIUM, Species::NEUTRON, dt_reaction::E_neutron, Species::HELIUM4, dt_reaction::E_He4 },
+        { "He3(d,p)He4", Species::DEUTERIUM, Species::HELIUM3, Species::PROTON, dhe3_reaction::E_proton, Species::HELIUM4, dhe3_reaction::E_He4 }
+    };
+    static_assert(sizeof(entries) / sizeof(entries[0]) == CHANNEL_COUNT, "channel table out of sync");
+    return entries;
+}
+
+double ReactionModelMultiChannel::boschHale(const Channel channel, const double energy_keV)
+{
+    if (energy_keV <= 0.0)
+    {
+        return 0.0;
+    }
+
+    double E = energy_keV;
+    double BG = 0.0;
+    double numerator = 0.0;
+    double denominator = 1.0;
+    switch (channel)
+    {
+    case DD_N:
+    {
+        using namespace constants::dd_reaction;
+        BG = constants::dd_reaction::BG;
+        numerator = A1 + E * (A2 + E * (A3 + E * (A4 + E * A5)));
+        break;
+    }
+    case DD_P:
+    {
+        using namespace constants::dd_reaction;
+        BG = constants::dd_reaction::BG;
+        numerator = A1_Tp + E * (A2_Tp + E * (A3_Tp + E * (A4_Tp + E * A5_Tp)));
+        break;
+    }
+    case DT:
+    {
+        using namespace constants::dt_reaction;
+        BG = constants::dt_reaction::BG;
+        E = std::min(E, E_fitMax);
+        numerator = A1 + E * (A2 + E * (A3 + E * (A4 + E * A5)));
+        denominator = 1.0 + E * (B1 + E * (B2 + E * (B3 + E * B4)));
+        break;
+    }
+    case DHE3:
+    {
+        using namespace constants::dhe3_reaction;
+        BG = constants::dhe3_reaction::BG;
+        numerator = A1 + E * (A2 + E * (A3 + E * A4));
+        denominator = 1.0 + E * (B1 + E * (B2 + E * B3));
+        break;
+    }
+    default:
+        return 0.0;
+    }
+
+    const double S = numerator / denominator;
+    const double sigma_mb = S / (E * std::exp(BG / std::sqrt(E)));
+    return std::max(sigma_mb, 0.0) * constants::millibarn;
+}
+
+double ReactionModelMultiChannel::lookup(const PairChannels& pair, const double energy_keV, double* sigma) const
+{
+    if (pair.count == 0 || energy_keV < minEnergy_keV)
+    {
+        std::fill(sigma, sigma + pair.count, 0.0);
+        return 0.0;
+    }
+
+    // bin and weight are shared by all channels of the pair, log-log interpolation follows the Gamow falloff
+    const double x = std::min((std::log(energy_keV) - m_logMinEnergy) * m_invLogStep, static_cast<double>(tableSize - 1));
+    const size_t bin = std::min(static_cast<size_t>(x), tableSize - 2);
+    const double w = x - bin;
+    const double* lower = &m_logSigma[bin * CHANNEL_COUNT];
+    const double* upper = lower + CHANNEL_COUNT;
+
+    double total = 0.0;
+    for (uint8_t k = 0; k < pair.count; ++k)
+    {
+        const uint8_t c = pair.channels[k];
+        sigma[k] = std::exp(lower[c] + w * (upper[c] - lower[c]));
+        total += sigma[k];
+    }
+    return total;
+}
+
+double ReactionModelMultiChannel::getCrossSection(const double energy_keV) const
+{
+    return getPairCrossSection(Species::DEUTERIUM, Species::DEUTERIUM, energy_keV);
+}
+
+double ReactionModelMultiChannel::getPairCrossSection(const Species a, const Species b, const double energy_keV) const
+{
+    const PairChannels& pair = m_dispatch[static_cast<size_t>(a)][static_cast<size_t>(b)];
+    double sigma[CHANNEL_COUNT];
+    return lookup(pair, energy_keV, sigma);
+}
+
+double ReactionModelMultiChannel::getThresholdEnergy() const
+{
+    return minEnergy_keV;
+}
+
+double ReactionModelMultiChannel::getChannelCrossSection(const Channel channel, const double energy_keV) const
+{
+    PairChannels single;
+    single.count = 1;
+    single.channels[0] = channel;
+    double sigma[1];
+    return lookup(single, energy_keV, sigma);
+}
+
+std::vector<std::unique_ptr<IParticleModel>> ReactionModelMultiChannel::react(
+    const std::vector<std::unique_ptr<IParticleModel>>& reactants)
+{
+    std::vector<std::unique_ptr<IParticleModel>> products;
+    if (reactants.size() < 2)
+    {
+        return products;
+    }
+
+    const PairChannels& pair = m_dispatch[static_cast<size_t>(reactants[0]->getSpecies())][static_cast<size_t>(reactants[1]->getSpecies())];
+    if (pair.count == 0)
+    {
+        return products;
+    }
+
+    const double m1 = reactants[0]->getMass();
+    const double m2 = reactants[1]->getMass();
+    const double reducedMass = (m1 * m2) / (m1 + m2);
+    const double v2 = (reactants[0]->getVelocity() - reactants[1]->getVelocity()).squaredNorm();
+    const double E_cm_keV = 0.5 * reducedMass * v2 / constants::keVtoJoule;
+
+    double sigma[CHANNEL_COUNT];
+    const double total = lookup(pair, E_cm_keV, sigma);
+
+    double u = 0.0;
+    double phival = 0.0;
+    double cosTheta = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(m_rngMutex);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        u = uniform(m_rng) * total;
+        phival = 2.0 * constants::pi * uniform(m_rng);
+        cosTheta = 2.0 * uniform(m_rng) - 1.0;
+    }
+
+    uint8_t pick = pair.channels[pair.count - 1];
+    for (uint8_t k = 0; k < pair.count; ++k)
+    {
+        if (u < sigma[k])
+        {
+            pick = pair.channels[k];
+            break;
+        }
+        u -= sigma[k];
+    }
+
+    const ChannelInfo& info = channelTable()[pick];
+    const Vector3d pos = (reactants[0]->getPosition() + reactants[1]->getPosition()) * 0.5;
+
+    const double sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta * cosTheta));
+    const Vector3d dir1(sinTheta * std::cos(phival), sinTheta * std::sin(phival), cosTheta);
+    const Vector3d dir2 = -dir1;
+
+    const double speedA = std::sqrt(2.0 * info.energyA_MeV * constants::MeVtoJoule / SpeciesTable::get(info.productA).mass);
+    const double speedB = std::sqrt(2.0 * info.energyB_MeV * constants::MeVtoJoule / SpeciesTable::get(info.productB).mass);
+
+    products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir1 * speedA, info.productA));
+    products.push_back(std::make_unique<ParticleModelSFPS>(pos, dir2 * speedB, info.productB));
+
+    return products;
+}
+
+std::string ReactionModelMultiChannel::getName() const
+{
+    std::string name = "Multi-channel";
+    const ChannelInfo* channels = channelTable();
+    for (int c = 0; c < CHANNEL_COUNT; ++c)
+    {
+        name += (c == 0 ? " (" : ", ");
+        name += channels[c].name;
+    }
+    return name + ")";
+}
+
+int ReactionModelMultiChannel::getBranch(const std::vector<std::unique_ptr<IParticleModel>>& products) const
+{
+    if (products.size() < 2)
+    {
+        return 0;
+    }
+
+    const ChannelInfo* channels = channelTable();
+    const Species a = products[0]->getSpecies();
+    const Species b = products[1]->getSpecies();
+    for (int c = 0; c < CHANNEL_COUNT; ++c)
+    {
+        if ((channels[c].productA == a && channels[c].productB == b) || (channels[c].productA == b && channels[c].productB == a))
+        {
+            return c;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "IReactionModel.h"
+#include "Species.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Mixed-fuel reaction model, all D-D, D-T and D-He3 channels of a pair from one shared cross-section table. \class ReactionModelMultiChannel
+    class ReactionModelMultiChannel : public IReactionModel
+    {
+    public:
+        /// @brief Reaction channels, in the order of the cross-section table. \enum Channel
+        enum Channel : uint8_t
+        {
+            DD_N,
+            DD_P,
+            DT,
+            DHE3,
+            CHANNEL_COUNT
+        };
+
+        /// @brief Lower end of the cross-section table in keV, pairs below react with probability 0.
+        static constexpr double minEnergy_keV = 0.5;
+
+        /// @brief Upper end of the cross-section table in keV, the cross sections are held constant above.
+        /// The D-T channel is held constant from 550 keV on, where its Bosch-Hale fit ends.
+        static constexpr double maxEnergy_keV = 5000.0;
+
+        /// @brief Number of log-spaced energies in the cross-section table.
+        static constexpr size_t tableSize = 1024;
+
+        /**
+         * @brief Constructor for ReactionModelMultiChannel, fills the cross-section table and the pair dispatch table.
+         */
+        ReactionModelMultiChannel();
+
+        /**
+         * @brief Getter for the D-D cross section, summed over both branches.
+         * @param energy_keV The energy in keV.
+         * @return A double represting the cross section.
+         */
+        [[nodiscard]] double getCrossSection(double energy_keV) const override;
+
+        /**
+         * @brief Getter for the total cross section of a species pair, all applicable channels in one table lookup.
+         * @param a Species of the first particle.
+         * @param b Species of the second particle.
+         * @param energy_keV The centre-of-mass energy in keV.
+         * @return The summed cross section, 0 if no channel applies to the pair.
+         */
+        [[nodiscard]] double getPairCrossSection(Species a, Species b, double energy_keV) const override;
+
+        /**
+         * @brief Getter for the threshold energy, the lower end of the cross-section table.
+         * @return The threshold energy in keV.
+         */
+        [[nodiscard]] double getThresholdEnergy() const override;
+
+        /**
+         * @brief Getter for the cross section of a single channel.
+         * @param channel The channel.
+         * @param energy_keV The centre-of-mass energy in keV.
+         * @return The cross section interpolated from the table.
+         */
+        [[nodiscard]] double getChannelCrossSection(Channel channel, double energy_keV) const;
+
+        /**
+         * @brief Method to start reaction, one channel of the pair is sampled by its share of the cross section.
+         * @param reactants The particle model.
+         * @return A vector of unqPtrs with the react, empty if the pair has no channel.
+         */
+        std::vector<std::unique_ptr<IParticleModel>> react(
+            const std::vector<std::unique_ptr<IParticleModel>>& reactants) override;
+
+        /**
+         * @brief Getter for the Name of the react.
+         * @return A String represnting the name.
+         */
+        [[nodiscard]] std::string getName() const override;
+
+        /**
+         * @brief Getter for the channel of a set of products.
+         * @param products The products returned by react().
+         * @return The Channel index.
+         */
+        [[nodiscard]] int getBranch(const std::vector<std::unique_ptr<IParticleModel>>& products) const override;
+
+        /**
+         * @brief Bosch-Hale parametrisation of a fusion cross section, D-T is held at its 550 keV value above.
+         * @param channel The channel.
+         * @param energy_keV The centre-of-mass energy in keV.
+         * @return The cross section in m^2.
+         */
+        [[nodiscard]] static double boschHale(Channel channel, double energy_keV);
+
+    private:
+        /// @brief Reactants and products of a channel. \struct ChannelInfo
+        struct ChannelInfo
+        {
+            const char* name;
+            Species reactantA;
+            Species reactantB;
+            Species productA;
+            double energyA_MeV;
+            Species productB;
+            double energyB_MeV;
+        };
+
+        /// @brief Channels open to one species pair. \struct PairChannels
+        struct PairChannels
+        {
+            uint8_t count = 0;
+            std::array<uint8_t, CHANNEL_COUNT> channels{};
+        };
+
+        /**
+         * @brief Getter for the channel table.
+         * @return Pointer to the first entry, in the order of the Channel enum.
+         */
+        static const ChannelInfo* channelTable();
+
+        /**
+         * @brief Interpolate the cross sections of the given channels at one energy.
+         * @param pair The channels to evaluate.
+         * @param energy_keV The centre-of-mass energy in keV.
+         * @param sigma Output, the cross section per entry of pair.channels.
+         * @return The summed cross section.
+         */
+        double lookup(const PairChannels& pair, double energy_keV, double* sigma) const;
+
+        std::vector<double> m_logSigma;
+        double m_logMinEnergy;
+        double m_invLogStep;
+        std::array<std::array<PairChannels, SpeciesTable::size()>, SpeciesTable::size()> m_dispatch;
+        std::mt19937 m_rng{std::random_device{}()};
+        std::mutex m_rngMutex;
+    };
+}
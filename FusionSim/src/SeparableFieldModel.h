@@ -0,0 +1,65 @@
+#pragma once
+#include "IFieldModel.h"
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Base for fields of the form spatial profile times drive waveform, E(r, t) = E(r) * f(t). \class SeparableFieldModel
+    class SeparableFieldModel : public IFieldModel
+    {
+    public:
+        /**
+         * @brief Getter for the electric field at a given position for the current step.
+         * @param position The position where the field is queried.
+         * @return The spatial profile scaled by the waveform cached in prepareStep().
+         */
+        [[nodiscard]] Vector3d getFieldAt(const Vector3d& position) const override
+        {
+            return getSpatialFieldAt(position) * m_stepFactor;
+        }
+
+        /**
+         * @brief Getter for the electric field at a given position and time.
+         * @param position The position where the field is queried.
+         * @param time The simulation time in seconds.
+         * @return The spatial profile scaled by the waveform at the given time.
+         */
+        [[nodiscard]] Vector3d getFieldAt(const Vector3d& position, const double time) const override
+        {
+            return getSpatialFieldAt(position) * getWaveform(time);
+        }
+
+        /**
+         * @brief Evaluate the waveform once for the step, at its midpoint.
+         * @param time The simulation time at the start of the step in seconds.
+         * @param dt The time step in seconds.
+         */
+        void prepareStep(const double time, const double dt) override
+        {
+            m_stepFactor = getWaveform(time + 0.5 * dt);
+        }
+
+        /**
+         * @brief Getter for the waveform factor of the current step.
+         * @return The cached waveform factor.
+         */
+        [[nodiscard]] double getStepFactor() const { return m_stepFactor; }
+
+        /**
+         * @brief Getter for the time-independent spatial profile of the field.
+         * @param position The position where the field is queried.
+         * @return The field vector for a unit waveform.
+         */
+        [[nodiscard]] virtual Vector3d getSpatialFieldAt(const Vector3d& position) const = 0;
+
+        /**
+         * @brief Getter for the drive waveform.
+         * @param time The simulation time in seconds.
+         * @return The dimensionless waveform factor.
+         */
+        [[nodiscard]] virtual double getWaveform(double time) const = 0;
+
+    protected:
+        double m_stepFactor = 1.0;
+    };
+}
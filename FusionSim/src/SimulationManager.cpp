@@ -1,6 +1,10 @@
 #include "SimulationManager.h"
 #include "PhysicalConstants.h"
 #include "FarnsworthFusorFieldModel.h"
+#include "CollisionModel.h"
+#include "FusorOrbitPropagator.h"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <vector>
@@ -18,6 +22,45 @@ namespace
         i = n - 2 - static_cast<size_t>(std::floor(std::sqrt(static_cast<double>(-8 * k + 4 * n * (n - 1) - 7)) / 2.0 - 0.5));
         j = k + i + 1 - n * (n - 1) / 2 + (n - i) * ((n - i) - 1) / 2;
     }
+
+    inline int currentThread()
+    {
+#ifdef USE_OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Time a linear relative track r0 + v * s, s in [0, duration], spends inside a sphere.
+     * @param r0 Relative position at the start of the step.
+     * @param v Relative velocity.
+     * @param duration Length of the step.
+     * @param radius Radius of the interaction sphere.
+     * @return The time spent inside the sphere, 0 if the track misses it.
+     */
+    inline double timeInsideRadius(const Vector3d& r0, const Vector3d& v, const double duration, const double radius)
+    {
+        const double a = v.squaredNorm();
+        const double c = r0.squaredNorm() - radius * radius;
+        if (a < 1e-30)
+        {
+            return c <= 0.0 ? duration : 0.0;
+        }
+
+        const double halfB = r0.dot(v);
+        const double disc = halfB * halfB - a * c;
+        if (disc <= 0.0)
+        {
+            return 0.0;
+        }
+
+        const double sqrtDisc = std::sqrt(disc);
+        const double sEnter = (-halfB - sqrtDisc) / a;
+        const double sExit = (-halfB + sqrtDisc) / a;
+        return std::max(0.0, std::min(duration, sExit) - std::max(0.0, sEnter));
+    }
 }
 
 
@@ -29,7 +72,22 @@ SimulationManager::SimulationManager()
     , m_numThreads(1)
     , m_thermalModel(nullptr)
     , m_enableThermalDynamics(false)
+    , m_enableCoulombCollisions(false)
+    , m_collisionCellSize(5.0e-3)
+    , m_coulombLogarithm(10.0)
+    , m_sweptCollisionDetection(false)
+    , m_analyticPropagation(false)
+    , m_pairPruning(false)
+    , m_candidatePairCount(0)
+    , m_prunedPairCount(0)
+    , m_symmetry(SymmetryMode::FULL)
+    , m_wireHitCount(0)
+    , m_sortInterval(0)
+    , m_pushSeconds{ 0.0, 0.0 }
+    , m_pushCount{ 0, 0 }
+    , m_stepEndTime(0.0)
 {
+    m_subcycles.fill(1);
 #ifdef USE_OPENMP
     m_numThreads = omp_get_max_threads();
 #endif
@@ -81,14 +139,37 @@ int SimulationManager::getNumThreads() const
 template <typename RNG, typename OutputIt>
 void SimulationManager::processPair(const size_t i, const size_t j, const double dt, RNG& rng, OutputIt out)
 {
-    const Vector3d dr = m_particles[i]->getPosition() - m_particles[j]->getPosition();
-    const double distance = dr.norm();
-    if (distance > m_collisionRadius)
+    // in a reduced domain particle i also meets the mirror images of j behind the reflecting planes
+    const unsigned images = m_symmetry.getWeight();
+    for (unsigned mask = 0; mask < images; ++mask)
+    {
+        testPair(i, j, mask, 1.0, dt, rng, out);
+    }
+}
+
+template <typename RNG, typename OutputIt>
+void SimulationManager::testPair(const size_t i, const size_t j, const unsigned mask, const double pairWeight, const double dt, RNG& rng, OutputIt out)
+{
+    const Vector3d posJ = SymmetryDomain::mirror(m_particles[j]->getPosition(), mask);
+    const Vector3d velJ = SymmetryDomain::mirror(m_particles[j]->getVelocity(), mask);
+    const Vector3d dr = m_particles[i]->getPosition() - posJ;
+    const Vector3d vRel = m_particles[i]->getVelocity() - velJ;
+
+    double exposure = dt;
+    if (m_sweptCollisionDetection)
+    {
+        // positions are end-of-step, so the relative track is extrapolated back linearly over the step
+        exposure = timeInsideRadius(dr - vRel * dt, vRel, dt, m_collisionRadius);
+        if (exposure <= 0.0)
+        {
+            return;
+        }
+    }
+    else if (dr.squaredNorm() > m_collisionRadius * m_collisionRadius)
     {
         return;
     }
 
-    const Vector3d vRel = m_particles[i]->getVelocity() - m_particles[j]->getVelocity();
     const double v = vRel.norm();
 
     const double m1 = m_particles[i]->getMass();
@@ -98,8 +179,13 @@ void SimulationManager::processPair(const size_t i, const size_t j, const double
     const double E_cm_J = 0.5 * reducedMass * v * v;
     const double E_cm_keV = E_cm_J / constants::keVtoJoule;
 
-    const double sigma = m_reactionModel->getCrossSection(E_cm_keV);
-    const double prob = sigma * v * dt * m_particleDensity;
+    // pairs without an open channel (e.g. a product and a fuel ion) end here, before any random draw
+    const double sigma = m_reactionModel->getPairCrossSection(m_particles[i]->getSpecies(), m_particles[j]->getSpecies(), E_cm_keV);
+    if (sigma <= 0.0)
+    {
+        return;
+    }
+    const double prob = sigma * v * exposure * m_particleDensity * pairWeight;
 
     std::uniform_real_distribution<double> uniform(0.0, 1.0);
 
@@ -108,14 +194,47 @@ void SimulationManager::processPair(const size_t i, const size_t j, const double
         std::vector<std::unique_ptr<IParticleModel>> reactants;
         reactants.push_back(m_particles[i]->clone());
         reactants.push_back(m_particles[j]->clone());
+        if (mask != 0)
+        {
+            reactants[1]->setPosition(posJ);
+            reactants[1]->setVelocity(velJ);
+        }
+
+        auto products = m_reactionModel->react(reactants);
 
-        auto products = m_reactionModel->react(
-            reactants,
-            m_fieldModel,
-            m_magFieldModel);
+        const Vector3d fusionPos = m_symmetry.fold((m_particles[i]->getPosition() + posJ) * 0.5);
+
+        if (m_diagnostics)
+        {
+            m_diagnostics->recordFusion(currentThread(), fusionPos, m_symmetry.getWeight());
+        }
+
+        if (m_eventLog)
+        {
+            FusionEventRecord record{};
+            record.time = m_stepEndTime;
+            record.position[0] = static_cast<float>(fusionPos.x);
+            record.position[1] = static_cast<float>(fusionPos.y);
+            record.position[2] = static_cast<float>(fusionPos.z);
+            record.energyCM_keV = static_cast<float>(E_cm_keV);
+            record.branch = static_cast<uint16_t>(m_reactionModel->getBranch(products));
+            record.weight = m_symmetry.getWeight();
+            record.productCount = static_cast<uint16_t>(std::min<size_t>(products.size(), 2));
+            for (size_t p = 0; p < record.productCount; ++p)
+            {
+                const double mass = products[p]->getMass();
+                record.productMass_amu[p] = static_cast<float>(mass / constants::massAMU);
+                record.productCharge_e[p] = static_cast<float>(products[p]->getCharge() / constants::eCharge);
+                record.productEnergy_MeV[p] = static_cast<float>(0.5 * mass * products[p]->getVelocity().squaredNorm() / constants::MeVtoJoule);
+            }
+            m_eventLog->append(currentThread(), record);
+        }
 
         for (auto& p : products)
+        {
+            m_symmetry.fold(*p);
             *out++ = std::move(p);
+        }
 
 #ifdef USE_OPENMP
         m_reactionCount.fetch_add(1, std::memory_order_relaxed);
@@ -125,14 +244,167 @@ void SimulationManager::processPair(const size_t i, const size_t j, const double
     }
 }
 
+size_t SimulationManager::buildSpeedOrderedPairs(const double thresholdEnergy_keV, std::vector<size_t>& order, std::vector<size_t>& first, double& minPairSpeed) const
+{
+    const size_t n = m_particles.size();
+    std::vector<double> speed(n);
+    double maxMass = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        speed[i] = m_particles[i]->getVelocity().norm();
+        maxMass = std::max(maxMass, m_particles[i]->getMass());
+    }
+
+    // E_cm = mu v_rel^2 / 2 with mu <= maxMass / 2 and v_rel <= |v_i| + |v_j|
+    minPairSpeed = 2.0 * std::sqrt(thresholdEnergy_keV * constants::keVtoJoule / maxMass);
+
+    order.resize(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&speed](const size_t a, const size_t b)
+    {
+        return speed[a] < speed[b];
+    });
+
+    // the slowest useful partner gets slower as the particle gets faster, so one pointer walks down once
+    first.resize(n);
+    size_t kept = 0;
+    size_t partner = n;
+    for (size_t a = 0; a < n; ++a)
+    {
+        while (partner > 0 && speed[order[a]] + speed[order[partner - 1]] >= minPairSpeed)
+        {
+            --partner;
+        }
+        first[a] = std::max(partner, a + 1);
+        kept += n - std::min(first[a], n);
+    }
+    return kept;
+}
+
+void SimulationManager::applyCoulombCollisions(const double dt, std::mt19937* rngs)
+{
+    m_cellGrid.build(m_particles, m_collisionCellSize);
+    const size_t numCells = m_cellGrid.getCellCount();
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (long long c = 0; c < static_cast<long long>(numCells); ++c)
+    {
+#ifdef USE_OPENMP
+        auto& rng = rngs[omp_get_thread_num()];
+#else
+        auto& rng = rngs[0];
+#endif
+        size_t* begin = m_cellGrid.cellBegin(c);
+        size_t* end = std::partition(begin, m_cellGrid.cellEnd(c), [this](const size_t idx)
+        {
+            return m_particles[idx]->getCharge() != 0.0;
+        });
+
+        const size_t count = static_cast<size_t>(end - begin);
+        if (count < 2)
+        {
+            continue;
+        }
+
+        std::shuffle(begin, end, rng);
+
+        size_t first = 0;
+        if (count % 2 == 1)
+        {
+            // odd cell: the first three particles collide cyclically with half the time step (Takizuka-Abe)
+            auto& a = *m_particles[begin[0]];
+            auto& b = *m_particles[begin[1]];
+            auto& d = *m_particles[begin[2]];
+            CollisionModel::coulombCollision(a, b, m_particleDensity, m_coulombLogarithm, 0.5 * dt, rng);
+            CollisionModel::coulombCollision(b, d, m_particleDensity, m_coulombLogarithm, 0.5 * dt, rng);
+            CollisionModel::coulombCollision(d, a, m_particleDensity, m_coulombLogarithm, 0.5 * dt, rng);
+            first = 3;
+        }
+
+        for (size_t k = first; k + 1 < count; k += 2)
+        {
+            CollisionModel::coulombCollision(*m_particles[begin[k]], *m_particles[begin[k + 1]], m_particleDensity, m_coulombLogarithm, dt, rng);
+        }
+    }
+}
+
 void SimulationManager::run(const double t_max, double dt)
 {
     double t = 0.0;
     size_t step = 0;
     m_reactionCount = 0;
+    m_wireHitCount = 0;
+    m_candidatePairCount = 0;
+    m_prunedPairCount = 0;
+    m_pushSeconds[0] = m_pushSeconds[1] = 0.0;
+    m_pushCount[0] = m_pushCount[1] = 0;
 
     auto* fusorField = dynamic_cast<FarnsworthFusorFieldModel*>(m_fieldModel.get());
 
+    const bool noMagneticField = !m_magFieldModel || m_magFieldModel->isZero();
+    const bool fieldFreeDrift = m_fieldModel && noMagneticField;
+
+    std::unique_ptr<FusorOrbitPropagator> orbitPropagator;
+    if (m_analyticPropagation && fusorField && noMagneticField)
+    {
+        orbitPropagator = std::make_unique<FusorOrbitPropagator>(*fusorField);
+    }
+
+    const FieldContext fields{ m_fieldModel.get(), m_magFieldModel.get() };
+
+    auto push = [&](IParticleModel& p, const double h)
+    {
+        if (orbitPropagator)
+        {
+            Vector3d pos = p.getPosition();
+            Vector3d vel = p.getVelocity();
+            if (orbitPropagator->propagate(pos, vel, SpeciesTable::get(p.getSpecies()).chargeOverMass, h))
+            {
+                p.setPosition(pos);
+                p.setVelocity(vel);
+                return;
+            }
+        }
+
+        if (fieldFreeDrift)
+        {
+            // straight flight up to the end of the step or the edge of the field-free region
+            const Vector3d vel = p.getVelocity();
+            const double drift = m_fieldModel->getFieldFreeTime(p.getPosition(), vel, h);
+            if (drift > 0.0)
+            {
+                p.setPosition(p.getPosition() + vel * drift);
+                if (drift < h)
+                {
+                    p.propagate(fields, h - drift);
+                }
+                return;
+            }
+        }
+        p.propagate(fields, h);
+    };
+
+    if (m_neutronTally)
+    {
+        m_neutronTally->setTimeWindow(t_max);
+    }
+
+    if (m_diagnostics)
+    {
+        m_diagnostics->prepare(m_numThreads);
+    }
+
+    if (m_eventLog && !m_eventLog->isOpen() && !m_eventLog->open(m_numThreads))
+    {
+        std::cout << "Unable to write the fusion event log, events are not logged\n";
+        m_eventLog.reset();
+    }
+
 #ifdef USE_OPENMP
     std::cout << "Running with " << m_numThreads << " OpenMP threads\n";
     std::vector<std::mt19937> threadRngs(m_numThreads);
@@ -144,19 +416,31 @@ void SimulationManager::run(const double t_max, double dt)
 
     while (t < t_max)
     {
-        const size_t n = m_particles.size();
+        size_t n = m_particles.size();
+
+        if (m_fieldModel)
+        {
+            m_fieldModel->prepareStep(t, dt);
+        }
 
-        if (fusorField && m_enableThermalDynamics && m_thermalModel && step % 100 == 0)
+        if (fusorField && m_enableThermalDynamics && m_thermalModel && n > 0 && step % 100 == 0)
         {
+            // the grid is heated by the ion current, electrons and neutrals would skew the averages
             double avgKE = 0.0, totalSpeed = 0.0;
+            size_t ions = 0;
             for (const auto& p : m_particles)
             {
+                if (p->getCharge() <= 0.0)
+                {
+                    continue;
+                }
                 const double v2 = p->getVelocity().squaredNorm();
                 avgKE += 0.5 * p->getMass() * v2;
                 totalSpeed += std::sqrt(v2);
+                ++ions;
             }
-            avgKE /= n;
-            const double avgSpeed = totalSpeed / n;
+            avgKE /= std::max<size_t>(ions, 1);
+            const double avgSpeed = totalSpeed / std::max<size_t>(ions, 1);
 
             const double gridRadius = fusorField->getInnerGridRadius();
             const double gridArea = 4.0 * constants::pi * gridRadius * gridRadius;
@@ -174,19 +458,90 @@ void SimulationManager::run(const double t_max, double dt)
             fusorField->setChamberTemperature(m_thermalModel->getChamberTemperature());
         }
 
+        if (m_sortInterval > 0 && step > 0 && step % m_sortInterval == 0)
+        {
+            m_spatialSort.reorder(m_particles, m_numThreads);
+        }
+
+        std::vector<char> absorbed;
+        if (m_cathodeWires)
+        {
+            absorbed.assign(n, 0);
+        }
+
+        const auto pushStart = std::chrono::steady_clock::now();
+
 #ifdef USE_OPENMP
         #pragma omp parallel for schedule(static)
 #endif
         for (long long i = 0; i < static_cast<long long>(n); ++i)
         {
-            m_particles[i]->propagate(dt);
+            auto& p = *m_particles[i];
+            // light species take several equal substeps, all species meet again at the end of the global step
+            const int cycles = m_subcycles[static_cast<size_t>(p.getSpecies())];
+            const double h = dt / cycles;
+            for (int c = 0; c < cycles; ++c)
+            {
+                const Vector3d start = p.getPosition();
+                push(p, h);
+                if (m_cathodeWires && p.getCharge() != 0.0 && m_cathodeWires->intersects(start, p.getPosition()))
+                {
+                    absorbed[i] = 1;
+                    break;
+                }
+            }
+            if (m_symmetry.isReduced())
+            {
+                m_symmetry.fold(p);
+            }
+        }
+
+        const int sortedBucket = m_spatialSort.getSortCount() > 0 ? 1 : 0;
+        m_pushSeconds[sortedBucket] += std::chrono::duration<double>(std::chrono::steady_clock::now() - pushStart).count();
+        m_pushCount[sortedBucket] += n;
+
+        if (m_cathodeWires)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (!absorbed[i])
+                {
+                    m_particles[kept++] = std::move(m_particles[i]);
+                }
+            }
+            m_wireHitCount += n - kept;
+            m_particles.resize(kept);
+            n = kept;
+        }
+
+        if (m_enableCoulombCollisions && n >= 2)
+        {
+#ifdef USE_OPENMP
+            applyCoulombCollisions(dt, threadRngs.data());
+#else
+            applyCoulombCollisions(dt, &m_rng);
+#endif
         }
 
         std::vector<std::unique_ptr<IParticleModel>> newParticles;
+        m_stepEndTime = t + dt;
 
         if (n >= 2)
         {
             const size_t numPairs = n * (n - 1) / 2;
+            m_candidatePairCount += numPairs;
+
+            // with pruning only pairs of the speed-sorted store whose summed speeds reach the threshold are visited
+            const bool pruning = m_pairPruning && m_reactionModel->getThresholdEnergy() > 0.0;
+            std::vector<size_t> speedOrder;
+            std::vector<size_t> firstPartner;
+            double minPairSpeed = 0.0;
+            if (pruning)
+            {
+                const size_t kept = buildSpeedOrderedPairs(m_reactionModel->getThresholdEnergy(), speedOrder, firstPartner, minPairSpeed);
+                m_prunedPairCount += numPairs - kept;
+            }
 
 #ifdef USE_OPENMP
             std::vector<std::vector<std::unique_ptr<IParticleModel>>> locals(m_numThreads);
@@ -197,12 +552,43 @@ void SimulationManager::run(const double t_max, double dt)
                 auto& rng = threadRngs[tid];
                 auto& local = locals[tid];
 
-                #pragma omp for schedule(static)
-                for (long long k = 0; k < static_cast<long long>(numPairs); ++k)
+                if (pruning)
                 {
-                    size_t i, j;
-                    indexToPair(k, n, i, j);
-                    processPair(i, j, dt, rng, std::back_inserter(local));
+                    #pragma omp for schedule(dynamic, 64)
+                    for (long long a = 0; a < static_cast<long long>(n); ++a)
+                    {
+                        for (size_t b = firstPartner[a]; b < n; ++b)
+                        {
+                            processPair(speedOrder[a], speedOrder[b], dt, rng, std::back_inserter(local));
+                        }
+                    }
+                }
+                else
+                {
+                    #pragma omp for schedule(static)
+                    for (long long k = 0; k < static_cast<long long>(numPairs); ++k)
+                    {
+                        size_t i, j;
+                        indexToPair(k, n, i, j);
+                        processPair(i, j, dt, rng, std::back_inserter(local));
+                    }
+                }
+
+                if (m_symmetry.isReduced())
+                {
+                    // each particle against its own images, every such pair is shared by two images
+                    #pragma omp for schedule(static)
+                    for (long long i = 0; i < static_cast<long long>(n); ++i)
+                    {
+                        if (pruning && 2.0 * m_particles[i]->getVelocity().norm() < minPairSpeed)
+                        {
+                            continue;
+                        }
+                        for (unsigned mask = 1; mask < m_symmetry.getWeight(); ++mask)
+                        {
+                            testPair(i, i, mask, 0.5, dt, rng, std::back_inserter(local));
+                        }
+                    }
                 }
             }
 
@@ -214,35 +600,107 @@ void SimulationManager::run(const double t_max, double dt)
                 }
             }
 #else
-            for (size_t k = 0; k < numPairs; ++k)
+            if (pruning)
+            {
+                for (size_t a = 0; a < n; ++a)
+                {
+                    for (size_t b = firstPartner[a]; b < n; ++b)
+                    {
+                        processPair(speedOrder[a], speedOrder[b], dt, m_rng, std::back_inserter(newParticles));
+                    }
+                }
+            }
+            else
+            {
+                for (size_t k = 0; k < numPairs; ++k)
+                {
+                    size_t i, j;
+                    indexToPair(k, n, i, j);
+                    processPair(i, j, dt, m_rng, std::back_inserter(newParticles));
+                }
+            }
+
+            if (m_symmetry.isReduced())
             {
-                size_t i, j;
-                indexToPair(k, n, i, j);
-                processPair(i, j, dt, m_rng, std::back_inserter(newParticles));
+                // each particle against its own images, every such pair is shared by two images
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (pruning && 2.0 * m_particles[i]->getVelocity().norm() < minPairSpeed)
+                    {
+                        continue;
+                    }
+                    for (unsigned mask = 1; mask < m_symmetry.getWeight(); ++mask)
+                    {
+                        testPair(i, i, mask, 0.5, dt, m_rng, std::back_inserter(newParticles));
+                    }
+                }
             }
 #endif
         }
 
         for (auto& p : newParticles)
         {
+            if (m_neutronTally && p->getCharge() == 0.0)
+            {
+                // neutral products fly straight out of the chamber, tally them and drop them, unfolded over all images of the domain
+                for (unsigned mask = 0; mask < m_symmetry.getWeight(); ++mask)
+                {
+                    m_neutronTally->record(SymmetryDomain::mirror(p->getPosition(), mask), SymmetryDomain::mirror(p->getVelocity(), mask), p->getMass(), m_stepEndTime);
+                }
+                continue;
+            }
             m_particles.push_back(std::move(p));
         }
 
+        if (m_eventLog)
+        {
+            m_eventLog->commit();
+        }
+
         t += dt;
         ++step;
 
+        if (m_diagnostics && m_diagnostics->isSampleStep(step))
+        {
+            writeDiagnostics(step, t);
+        }
+
         if (step % 1000 == 0)
         {
             std::cout << "\rProgress: "
                       << int(100.0 * t / t_max)
                       << "%  Particles: " << m_particles.size()
-                      << "  Reactions: " << m_reactionCount
+                      << "  Reactions: " << getReactionCount()
                       << std::flush;
         }
     }
+    if (m_diagnostics && !m_diagnostics->isSampleStep(step))
+    {
+        writeDiagnostics(step, t);
+    }
+
+    if (m_eventLog)
+    {
+        m_eventLog->close();
+    }
     std::cout << "\n";
 }
 
+void SimulationManager::writeDiagnostics(const size_t step, const double t)
+{
+    const size_t n = m_particles.size();
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long long i = 0; i < static_cast<long long>(n); ++i)
+    {
+        m_diagnostics->accumulateParticle(currentThread(), *m_particles[i], m_symmetry.getWeight());
+    }
+
+    m_diagnostics->write(step, t, getReactionCount());
+}
+
 const std::vector<std::unique_ptr<IParticleModel>>& SimulationManager::getParticles() const
 {
     return m_particles;
@@ -260,7 +718,7 @@ std::shared_ptr<IMagneticFieldModel> SimulationManager::getMagneticFieldModel()
 
 size_t SimulationManager::getReactionCount() const
 {
-    return m_reactionCount;
+    return m_reactionCount * m_symmetry.getWeight();
 }
 
 void SimulationManager::enableThermalDynamics(const bool enable)
@@ -276,3 +734,114 @@ ThermalDynamicsModel* SimulationManager::getThermalModel() const
 {
     return m_thermalModel.get();
 }
+
+void SimulationManager::enableCoulombCollisions(const bool enable)
+{
+    m_enableCoulombCollisions = enable;
+}
+
+void SimulationManager::setCollisionCellSize(const double size)
+{
+    m_collisionCellSize = size;
+}
+
+void SimulationManager::setCoulombLogarithm(const double coulombLogarithm)
+{
+    m_coulombLogarithm = coulombLogarithm;
+}
+
+void SimulationManager::enableSweptCollisionDetection(const bool enable)
+{
+    m_sweptCollisionDetection = enable;
+}
+
+void SimulationManager::setSubcycles(const Species species, const int cycles)
+{
+    m_subcycles[static_cast<size_t>(species)] = std::max(cycles, 1);
+}
+
+int SimulationManager::getSubcycles(const Species species) const
+{
+    return m_subcycles[static_cast<size_t>(species)];
+}
+
+void SimulationManager::enablePairPruning(const bool enable)
+{
+    m_pairPruning = enable;
+}
+
+size_t SimulationManager::getCandidatePairCount() const
+{
+    return m_candidatePairCount;
+}
+
+size_t SimulationManager::getPrunedPairCount() const
+{
+    return m_prunedPairCount;
+}
+
+void SimulationManager::enableAnalyticPropagation(const bool enable)
+{
+    m_analyticPropagation = enable;
+}
+
+void SimulationManager::setSymmetryMode(const SymmetryMode mode)
+{
+    m_symmetry = SymmetryDomain(mode);
+}
+
+const SymmetryDomain& SimulationManager::getSymmetryDomain() const
+{
+    return m_symmetry;
+}
+
+void SimulationManager::setCathodeWires(std::unique_ptr<GridWireGeometry> wires)
+{
+    m_cathodeWires = std::move(wires);
+}
+
+size_t SimulationManager::getWireHitCount() const
+{
+    return m_wireHitCount;
+}
+
+void SimulationManager::setSortInterval(const size_t steps)
+{
+    m_sortInterval = steps;
+}
+
+const SpatialSort& SimulationManager::getSpatialSort() const
+{
+    return m_spatialSort;
+}
+
+double SimulationManager::getPushTimePerParticle(const bool sorted) const
+{
+    const int bucket = sorted ? 1 : 0;
+    return m_pushCount[bucket] > 0 ? 1.0e9 * m_pushSeconds[bucket] / static_cast<double>(m_pushCount[bucket]) : 0.0;
+}
+
+void SimulationManager::setNeutronTally(std::unique_ptr<NeutronTally> tally)
+{
+    m_neutronTally = std::move(tally);
+}
+
+NeutronTally* SimulationManager::getNeutronTally() const
+{
+    return m_neutronTally.get();
+}
+
+void SimulationManager::setDiagnostics(std::unique_ptr<Diagnostics> diagnostics)
+{
+    m_diagnostics = std::move(diagnostics);
+}
+
+void SimulationManager::setEventLog(std::unique_ptr<FusionEventLog> log)
+{
+    m_eventLog = std::move(log);
+}
+
+FusionEventLog* SimulationManager::getEventLog() const
+{
+    return m_eventLog.get();
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <vector>
 #include <random>
@@ -8,6 +9,13 @@
 #include "IReactionModel.h"
 #include "IParticleModel.h"
 #include "ThermalDynamicsModel.h"
+#include "CellGrid.h"
+#include "NeutronTally.h"
+#include "Diagnostics.h"
+#include "FusionEventLog.h"
+#include "SymmetryDomain.h"
+#include "GridWireGeometry.h"
+#include "SpatialSort.h"
 
 #ifdef USE_OPENMP
 #include <omp.h>
@@ -94,7 +102,7 @@ namespace fusion
 
         /**
          * @brief Getter for the reactions.
-         * @return Count of reactions.
+         * @return Count of reactions, scaled to the full sphere in a symmetry-reduced run.
          */
         [[nodiscard]] size_t getReactionCount() const;
 
@@ -116,6 +124,141 @@ namespace fusion
          */
         [[nodiscard]] ThermalDynamicsModel* getThermalModel() const;
 
+        /**
+         * @brief Enable or disable the binary Coulomb collision operator.
+         * @param enable True to enable, false to disable.
+         */
+        void enableCoulombCollisions(bool enable);
+
+        /**
+         * @brief Setter for the cell size used to pair particles for Coulomb collisions.
+         * @param size The cell edge length in meters.
+         */
+        void setCollisionCellSize(double size);
+
+        /**
+         * @brief Setter for the Coulomb logarithm.
+         * @param coulombLogarithm The Coulomb logarithm ln(Lambda).
+         */
+        void setCoulombLogarithm(double coulombLogarithm);
+
+        /**
+         * @brief Enable or disable swept (continuous) collision detection for fusion pairs.
+         * @param enable True to test the relative track over the whole step, false to test only the end positions.
+         */
+        void enableSweptCollisionDetection(bool enable);
+
+        /**
+         * @brief Setter for the number of substeps a species takes per global time step.
+         * @param species The species.
+         * @param cycles Number of equal substeps of dt / cycles, fusion, collisions and diagnostics still run once per global step.
+         */
+        void setSubcycles(Species species, int cycles);
+
+        /**
+         * @brief Getter for the number of substeps of a species.
+         * @param species The species.
+         * @return The number of substeps per global time step.
+         */
+        [[nodiscard]] int getSubcycles(Species species) const;
+
+        /**
+         * @brief Enable or disable the pruning of fusion pairs below the threshold energy of the reaction model.
+         * @param enable True to skip pairs whose summed speeds cannot reach the threshold, before any per-pair work.
+         */
+        void enablePairPruning(bool enable);
+
+        /**
+         * @brief Getter for the number of candidate fusion pairs, summed over all steps of the last run().
+         * @return The number of pairs.
+         */
+        [[nodiscard]] size_t getCandidatePairCount() const;
+
+        /**
+         * @brief Getter for the number of fusion pairs skipped by the threshold pruning, summed over all steps of the last run().
+         * @return The number of pruned pairs.
+         */
+        [[nodiscard]] size_t getPrunedPairCount() const;
+
+        /**
+         * @brief Enable or disable the analytic orbit propagation in the fusor field.
+         * @param enable True to advance particles on exact Kepler orbits when no magnetic field is present.
+         */
+        void enableAnalyticPropagation(bool enable);
+
+        /**
+         * @brief Setter for the symmetry reduction. Only valid for spherically symmetric fields and spawn distributions.
+         * @param mode The symmetry mode, particles leaving the domain are reflected at its planes.
+         */
+        void setSymmetryMode(SymmetryMode mode);
+
+        /**
+         * @brief Getter for the symmetry domain.
+         * @return The symmetry domain.
+         */
+        [[nodiscard]] const SymmetryDomain& getSymmetryDomain() const;
+
+        /**
+         * @brief Setter for the wire-resolved cathode. Charged particles whose path crosses a wire are absorbed.
+         * @param wires The wire geometry, nullptr for a fully transparent cathode.
+         */
+        void setCathodeWires(std::unique_ptr<GridWireGeometry> wires);
+
+        /**
+         * @brief Getter for the number of particles absorbed on the cathode wires.
+         * @return The number of absorbed particles.
+         */
+        [[nodiscard]] size_t getWireHitCount() const;
+
+        /**
+         * @brief Setter for the interval of the spatial reordering of the particle store.
+         * @param steps Reorder along the Morton curve every this many steps, 0 to disable.
+         */
+        void setSortInterval(size_t steps);
+
+        /**
+         * @brief Getter for the spatial sort and its locality statistics.
+         * @return The spatial sort.
+         */
+        [[nodiscard]] const SpatialSort& getSpatialSort() const;
+
+        /**
+         * @brief Getter for the measured push time per particle.
+         * @param sorted True for the steps after the first reordering, false for the steps before it.
+         * @return The mean wall time of one particle push in nanoseconds, 0 if no such step was run.
+         */
+        [[nodiscard]] double getPushTimePerParticle(bool sorted) const;
+
+        /**
+         * @brief Setter for the neutron tally. Neutral products are tallied and dropped instead of being pushed.
+         * @param tally The tally, nullptr to keep neutral products in the particle list.
+         */
+        void setNeutronTally(std::unique_ptr<NeutronTally> tally);
+
+        /**
+         * @brief Getter for the neutron tally.
+         * @return Pointer to the neutron tally, nullptr if not set.
+         */
+        [[nodiscard]] NeutronTally* getNeutronTally() const;
+
+        /**
+         * @brief Setter for the in-situ diagnostics written during the run.
+         * @param diagnostics The diagnostics, nullptr to disable them.
+         */
+        void setDiagnostics(std::unique_ptr<Diagnostics> diagnostics);
+
+        /**
+         * @brief Setter for the binary fusion event log. A log not yet opened is opened by run(); if that fails, run() drops it.
+         * @param log The event log, nullptr to disable it. If already open, it must have been opened for getNumThreads() threads.
+         */
+        void setEventLog(std::unique_ptr<FusionEventLog> log);
+
+        /**
+         * @brief Getter for the binary fusion event log.
+         * @return Pointer to the event log, nullptr if not set.
+         */
+        [[nodiscard]] FusionEventLog* getEventLog() const;
+
         /**
          * @brief Process a pair of particles for potential reactions.
          * @tparam RNG The type of random number generator.
@@ -129,6 +272,44 @@ namespace fusion
         template <typename RNG, typename OutputIt>
         void processPair(size_t i, size_t j, double dt, RNG& rng, OutputIt out);
 
+        /**
+         * @brief Test particle i against an image of particle j for a reaction.
+         * @tparam RNG The type of random number generator.
+         * @tparam OutputIt The type of output iterator.
+         * @param i Index of the first particle.
+         * @param j Index of the second particle, may equal i for a self-image pair.
+         * @param mask Reflecting planes applied to particle j, see SymmetryDomain::mirror.
+         * @param pairWeight Scale of the reaction probability, 0.5 for a particle and its own image.
+         * @param dt Time step.
+         * @param rng Random number generator.
+         * @param out Output iterator to store new particles.
+         */
+        template <typename RNG, typename OutputIt>
+        void testPair(size_t i, size_t j, unsigned mask, double pairWeight, double dt, RNG& rng, OutputIt out);
+
+        /**
+         * @brief Sort the particles by speed and find, for each one, the first faster partner that can reach the threshold energy.
+         * @param thresholdEnergy_keV The threshold energy of the reaction model.
+         * @param order Output, particle indices in ascending order of speed.
+         * @param first Output, for each position in order the first position of a partner worth testing.
+         * @param minPairSpeed Output, the smallest sum of two speeds for which a pair can reach the threshold.
+         * @return The number of pairs kept.
+         */
+        size_t buildSpeedOrderedPairs(double thresholdEnergy_keV, std::vector<size_t>& order, std::vector<size_t>& first, double& minPairSpeed) const;
+
+        /**
+         * @brief Apply the binary Coulomb collision operator to all charged particles.
+         * @param dt Time step.
+         * @param rngs Random number generators, one per thread.
+         */
+        void applyCoulombCollisions(double dt, std::mt19937* rngs);
+
+        /**
+         * @brief Accumulate the particle histograms and write a diagnostics snapshot.
+         * @param step The step number.
+         * @param t The simulation time.
+         */
+        void writeDiagnostics(size_t step, double t);
 
     private:
         std::shared_ptr<IFieldModel> m_fieldModel;
@@ -142,5 +323,26 @@ namespace fusion
         int m_numThreads;
         std::unique_ptr<ThermalDynamicsModel> m_thermalModel;
         bool m_enableThermalDynamics;
+        bool m_enableCoulombCollisions;
+        double m_collisionCellSize;
+        double m_coulombLogarithm;
+        bool m_sweptCollisionDetection;
+        bool m_analyticPropagation;
+        bool m_pairPruning;
+        std::array<int, SpeciesTable::size()> m_subcycles;
+        size_t m_candidatePairCount;
+        size_t m_prunedPairCount;
+        SymmetryDomain m_symmetry;
+        std::unique_ptr<GridWireGeometry> m_cathodeWires;
+        size_t m_wireHitCount;
+        size_t m_sortInterval;
+        SpatialSort m_spatialSort;
+        double m_pushSeconds[2];
+        size_t m_pushCount[2];
+        std::unique_ptr<NeutronTally> m_neutronTally;
+        std::unique_ptr<Diagnostics> m_diagnostics;
+        std::unique_ptr<FusionEventLog> m_eventLog;
+        double m_stepEndTime;
+        CellGrid m_cellGrid;
     };
 }
\ No newline at end of file
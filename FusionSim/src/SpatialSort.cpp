@@ -0,0 +1,197 @@
+#include "SpatialSort.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace fusion;
+
+namespace
+{
+    constexpr int mortonBits = 21;
+    constexpr int radixBits = 8;
+    constexpr size_t radixBuckets = size_t(1) << radixBits;
+
+    inline uint64_t spreadBits(uint64_t v)
+    {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x1f00000000ffff;
+        v = (v | v << 16) & 0x1f0000ff0000ff;
+        v = (v | v << 8) & 0x100f00f00f00f00f;
+        v = (v | v << 4) & 0x10c30c30c30c30c3;
+        v = (v | v << 2) & 0x1249249249249249;
+        return v;
+    }
+}
+
+SpatialSort::SpatialSort()
+    : m_sortCount(0)
+    , m_gapBefore(0.0)
+    , m_gapAfter(0.0)
+{
+}
+
+uint64_t SpatialSort::mortonKey(const uint32_t ix, const uint32_t iy, const uint32_t iz)
+{
+    return (spreadBits(ix) << 2) | (spreadBits(iy) << 1) | spreadBits(iz);
+}
+
+double SpatialSort::meanNeighbourGap(const std::vector<std::unique_ptr<IParticleModel>>& particles)
+{
+    const size_t n = particles.size();
+    if (n < 2)
+    {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+#endif
+    for (long long i = 1; i < static_cast<long long>(n); ++i)
+    {
+        sum += (particles[i]->getPosition() - particles[i - 1]->getPosition()).norm();
+    }
+    return sum / static_cast<double>(n - 1);
+}
+
+void SpatialSort::reorder(std::vector<std::unique_ptr<IParticleModel>>& particles, const int numThreads)
+{
+    const size_t n = particles.size();
+    if (n < 2)
+    {
+        return;
+    }
+
+    m_gapBefore = meanNeighbourGap(particles);
+
+    Vector3d lo = particles[0]->getPosition();
+    Vector3d hi = lo;
+    for (const auto& p : particles)
+    {
+        const Vector3d pos = p->getPosition();
+        lo = Vector3d(std::min(lo.x, pos.x), std::min(lo.y, pos.y), std::min(lo.z, pos.z));
+        hi = Vector3d(std::max(hi.x, pos.x), std::max(hi.y, pos.y), std::max(hi.z, pos.z));
+    }
+
+    // one cubic box keeps the curve isotropic
+    const double extent = std::max({ hi.x - lo.x, hi.y - lo.y, hi.z - lo.z, 1e-30 });
+    const double scale = static_cast<double>((1u << mortonBits) - 1) / extent;
+
+    m_keys.resize(n);
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long long i = 0; i < static_cast<long long>(n); ++i)
+    {
+        const Vector3d pos = particles[i]->getPosition();
+        m_keys[i] = {
+            mortonKey(
+                static_cast<uint32_t>((pos.x - lo.x) * scale),
+                static_cast<uint32_t>((pos.y - lo.y) * scale),
+                static_cast<uint32_t>((pos.z - lo.z) * scale)),
+            static_cast<size_t>(i) };
+    }
+
+    radixSort(numThreads);
+
+    // fresh clones in curve order, so neighbours on the curve are also neighbours on the heap
+    std::vector<std::unique_ptr<IParticleModel>> sorted(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        sorted[i] = particles[m_keys[i].second]->clone();
+    }
+    particles.swap(sorted);
+
+    m_gapAfter = meanNeighbourGap(particles);
+    ++m_sortCount;
+}
+
+void SpatialSort::radixSort(const int numThreads)
+{
+    const size_t n = m_keys.size();
+    const int threads = std::max(1, std::min<int>(numThreads, static_cast<int>(n / radixBuckets) + 1));
+    m_scratch.resize(n);
+
+    std::vector<size_t> counts(threads * radixBuckets);
+    std::vector<size_t> totals(radixBuckets);
+
+    for (int shift = 0; shift < 3 * mortonBits; shift += radixBits)
+    {
+        std::fill(counts.begin(), counts.end(), 0);
+
+#ifdef USE_OPENMP
+        #pragma omp parallel for schedule(static, 1) num_threads(threads)
+#endif
+        for (int t = 0; t < threads; ++t)
+        {
+            size_t* local = counts.data() + t * radixBuckets;
+            const size_t begin = n * t / threads;
+            const size_t end = n * (t + 1) / threads;
+            for (size_t i = begin; i < end; ++i)
+            {
+                ++local[(m_keys[i].first >> shift) & (radixBuckets - 1)];
+            }
+        }
+
+        std::fill(totals.begin(), totals.end(), 0);
+        bool constantDigit = false;
+        for (size_t b = 0; b < radixBuckets; ++b)
+        {
+            for (int t = 0; t < threads; ++t)
+            {
+                totals[b] += counts[t * radixBuckets + b];
+            }
+            constantDigit = constantDigit || totals[b] == n;
+        }
+        if (constantDigit)
+        {
+            continue;
+        }
+
+        // exclusive offsets, bucket-major then thread, keep the pass stable
+        size_t offset = 0;
+        for (size_t b = 0; b < radixBuckets; ++b)
+        {
+            for (int t = 0; t < threads; ++t)
+            {
+                const size_t c = counts[t * radixBuckets + b];
+                counts[t * radixBuckets + b] = offset;
+                offset += c;
+            }
+        }
+
+#ifdef USE_OPENMP
+        #pragma omp parallel for schedule(static, 1) num_threads(threads)
+#endif
+        for (int t = 0; t < threads; ++t)
+        {
+            size_t* local = counts.data() + t * radixBuckets;
+            const size_t begin = n * t / threads;
+            const size_t end = n * (t + 1) / threads;
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_scratch[local[(m_keys[i].first >> shift) & (radixBuckets - 1)]++] = m_keys[i];
+            }
+        }
+
+        m_keys.swap(m_scratch);
+    }
+}
+
+size_t SpatialSort::getSortCount() const
+{
+    return m_sortCount;
+}
+
+double SpatialSort::getGapBefore() const
+{
+    return m_gapBefore;
+}
+
+double SpatialSort::getGapAfter() const
+{
+    return m_gapAfter;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "IParticleModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Reorders the particle store along a Morton curve with a parallel radix sort. \class SpatialSort
+    class SpatialSort
+    {
+    public:
+        /**
+         * @brief Constructor for SpatialSort.
+         */
+        SpatialSort();
+
+        /**
+         * @brief Sort the particles along the Morton curve of their bounding box and re-allocate them in that order.
+         * @param particles The particle store, reordered in place.
+         * @param numThreads Number of threads for the key computation and the radix sort.
+         */
+        void reorder(std::vector<std::unique_ptr<IParticleModel>>& particles, int numThreads);
+
+        /**
+         * @brief Interleave three 21 bit coordinates into a 63 bit Morton key.
+         * @param ix Coordinate along x.
+         * @param iy Coordinate along y.
+         * @param iz Coordinate along z.
+         * @return The Morton key.
+         */
+        static uint64_t mortonKey(uint32_t ix, uint32_t iy, uint32_t iz);
+
+        /**
+         * @brief Mean distance between particles that are neighbours in the store.
+         * @param particles The particle store.
+         * @return The mean distance in meters, a proxy for the cache locality of the ordering.
+         */
+        [[nodiscard]] static double meanNeighbourGap(const std::vector<std::unique_ptr<IParticleModel>>& particles);
+
+        /**
+         * @brief Getter for the number of sorts done so far.
+         * @return The number of sorts.
+         */
+        [[nodiscard]] size_t getSortCount() const;
+
+        /**
+         * @brief Getter for the mean neighbour gap right before the last sort.
+         * @return The gap in meters.
+         */
+        [[nodiscard]] double getGapBefore() const;
+
+        /**
+         * @brief Getter for the mean neighbour gap right after the last sort.
+         * @return The gap in meters.
+         */
+        [[nodiscard]] double getGapAfter() const;
+
+    private:
+        /**
+         * @brief Stable LSD radix sort of (key, index) pairs, 8 bits per pass, passes over constant bytes are skipped.
+         * @param numThreads Number of threads.
+         */
+        void radixSort(int numThreads);
+
+        std::vector<std::pair<uint64_t, size_t>> m_keys;
+        std::vector<std::pair<uint64_t, size_t>> m_scratch;
+        size_t m_sortCount;
+        double m_gapBefore;
+        double m_gapAfter;
+    };
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "PhysicalConstants.h"
+#include <cstddef>
+#include <cstdint>
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Particle species, stored as one byte per particle. \enum Species
+    enum class Species : uint8_t
+    {
+        DEUTERIUM,
+        TRITIUM,
+        PROTON,
+        NEUTRON,
+        HELIUM3,
+        HELIUM4,
+        ELECTRON,
+        COUNT
+    };
+
+    /// @brief Properties shared by all particles of a species. \struct SpeciesInfo
+    struct SpeciesInfo
+    {
+        const char* name;
+        double mass;
+        double charge;
+        double chargeOverMass;
+        bool fieldCoupled;
+    };
+
+    /// @brief Species table, the single place where masses and charges are defined. \class SpeciesTable
+    class SpeciesTable
+    {
+    public:
+        /**
+         * @brief Getter for the properties of a species.
+         * @param species The species.
+         * @return The table entry.
+         */
+        [[nodiscard]] static const SpeciesInfo& get(const Species species)
+        {
+            return table()[static_cast<size_t>(species)];
+        }
+
+        /**
+         * @brief Getter for the number of species.
+         * @return The number of table entries.
+         */
+        [[nodiscard]] static constexpr size_t size()
+        {
+            return static_cast<size_t>(Species::COUNT);
+        }
+
+    private:
+        /**
+         * @brief The table, in the order of the Species enum.
+         * @return Pointer to the first entry.
+         */
+        static const SpeciesInfo* table()
+        {
+            using namespace constants;
+            static constexpr SpeciesInfo entries[] = {
+                { "D", massDeuterium, eCharge, eCharge / massDeuterium, true },
+                { "T", massTritium, eCharge, eCharge / massTritium, true },
+                { "p", massProton, eCharge, eCharge / massProton, true },
+                { "n", massNeutron, 0.0, 0.0, false },
+                { "He3", massHe3, 2.0 * eCharge, 2.0 * eCharge / massHe3, true },
+                { "He4", massHe4, 2.0 * eCharge, 2.0 * eCharge / massHe4, true },
+                { "e", massElectron, -eCharge, -eCharge / massElectron, true }
+            };
+            static_assert(sizeof(entries) / sizeof(entries[0]) == static_cast<size_t>(Species::COUNT), "species table out of sync");
+            return entries;
+        }
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "IParticleModel.h"
+#include "Vector3dSimple.h"
+
+/// @brief FusionSim - a simulator for FFR \namespace  fusion
+namespace fusion
+{
+    /// @brief Symmetry reduction of a spherically symmetric run. \enum SymmetryMode
+    enum class SymmetryMode
+    {
+        FULL,       ///< Full sphere, no reflecting planes.
+        HALF,       ///< Half space x >= 0.
+        QUADRANT,   ///< Wedge x >= 0, y >= 0.
+        OCTANT      ///< Octant x >= 0, y >= 0, z >= 0.
+    };
+
+    /// @brief Simulation domain bounded by specular reflecting coordinate planes. \class SymmetryDomain
+    class SymmetryDomain
+    {
+    public:
+        /**
+         * @brief Constructor for SymmetryDomain.
+         * @param mode The symmetry mode.
+         */
+        explicit SymmetryDomain(const SymmetryMode mode = SymmetryMode::FULL)
+            : m_mode(mode)
+            , m_planeCount(static_cast<int>(mode))
+        {
+        }
+
+        /**
+         * @brief Getter for the symmetry mode.
+         * @return The symmetry mode.
+         */
+        [[nodiscard]] SymmetryMode getMode() const { return m_mode; }
+
+        /**
+         * @brief Check if the domain is smaller than the full sphere.
+         * @return True if at least one reflecting plane is active.
+         */
+        [[nodiscard]] bool isReduced() const { return m_planeCount > 0; }
+
+        /**
+         * @brief Getter for the number of images of the domain in the full sphere, including the domain itself.
+         * @return 1, 2, 4 or 8. Every simulated particle and reaction stands for this many in the full sphere.
+         */
+        [[nodiscard]] unsigned getWeight() const { return 1u << m_planeCount; }
+
+        /**
+         * @brief Mirror a vector at the reflecting planes selected by a mask.
+         * @param v The vector.
+         * @param mask Bit 0 mirrors x, bit 1 mirrors y, bit 2 mirrors z. Mask values below getWeight() are valid.
+         * @return The mirrored vector.
+         */
+        [[nodiscard]] static Vector3d mirror(const Vector3d& v, const unsigned mask)
+        {
+            return Vector3d(
+                (mask & 1u) ? -v.x : v.x,
+                (mask & 2u) ? -v.y : v.y,
+                (mask & 4u) ? -v.z : v.z);
+        }
+
+        /**
+         * @brief Mask of the planes a position lies behind.
+         * @param position The position.
+         * @return The mask that folds the position back into the domain.
+         */
+        [[nodiscard]] unsigned outsideMask(const Vector3d& position) const
+        {
+            unsigned mask = 0;
+            if (m_planeCount > 0 && position.x < 0.0) mask |= 1u;
+            if (m_planeCount > 1 && position.y < 0.0) mask |= 2u;
+            if (m_planeCount > 2 && position.z < 0.0) mask |= 4u;
+            return mask;
+        }
+
+        /**
+         * @brief Fold a position into the domain.
+         * @param position The position.
+         * @return The image of the position inside the domain.
+         */
+        [[nodiscard]] Vector3d fold(const Vector3d& position) const
+        {
+            return mirror(position, outsideMask(position));
+        }
+
+        /**
+         * @brief Specular reflection of a particle that left the domain through one or more planes.
+         * @param particle The particle, position and velocity are mirrored in place.
+         */
+        void fold(IParticleModel& particle) const
+        {
+            const unsigned mask = outsideMask(particle.getPosition());
+            if (mask != 0)
+            {
+                particle.setPosition(mirror(particle.getPosition(), mask));
+                particle.setVelocity(mirror(particle.getVelocity(), mask));
+            }
+        }
+
+    private:
+        SymmetryMode m_mode;
+        int m_planeCount;
+    };
+}
@@ -0,0 +1,86 @@
+#if !defined(BOUNDEDQUEUE_H)
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/// @brief Slice rendering pipeline: work queue, slice driver and PNG output. \namespace Pipeline
+namespace Pipeline
+{
+    /// @brief Blocking FIFO with a fixed capacity, producers wait while it is full. \class BoundedQueue
+    template <typename T>
+    class BoundedQueue
+    {
+    public:
+        /**
+         * @brief Constructor for BoundedQueue.
+         * @param capacity Maximum number of queued items, at least 1.
+         */
+        explicit BoundedQueue(std::size_t capacity)
+            : m_capacity(capacity > 0 ? capacity : 1)
+            , m_closed(false)
+        {
+        }
+
+        /**
+         * @brief Append an item, blocking while the queue is full.
+         * @param item The item.
+         * @return False if the queue was closed, the item is then dropped.
+         */
+        bool push(T item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+            if (m_closed)
+            {
+                return false;
+            }
+            m_items.push_back(std::move(item));
+            m_notEmpty.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest item, blocking while the queue is empty and open.
+         * @param item Output, the item.
+         * @return False once the queue is closed and drained.
+         */
+        bool pop(T &item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+            if (m_items.empty())
+            {
+                return false;
+            }
+            item = std::move(m_items.front());
+            m_items.pop_front();
+            m_notFull.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Close the queue, consumers drain the remaining items and then stop.
+         */
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_notEmpty.notify_all();
+            m_notFull.notify_all();
+        }
+
+    private:
+        std::size_t m_capacity;
+        bool m_closed;
+        std::deque<T> m_items;
+        std::mutex m_mutex;
+        std::condition_variable m_notEmpty;
+        std::condition_variable m_notFull;
+    };
+}
+
+#endif // BOUNDEDQUEUE_H
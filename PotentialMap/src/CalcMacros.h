@@ -93,5 +93,11 @@
 #define VACUUM_PERMITTIVITY(mean_free_path, vacuum_permittivity) \
     vacuum_permittivity = (mean_free_path * 1.602176487 * pow(10, -19)) / (8.854187817 * pow(10, -12));
 
+/*
+ * @brief The macro to calculate the Paschen breakdown voltage of a gap, with the constants FusionSim uses for deuterium
+ * (A = 15 1/(Pa m), B = 365 V/(Pa m), secondary emission 0.01); not positive left of the Paschen minimum, no breakdown there
+ */
+#define PASCHEN_BREAKDOWN(pressure, gap, breakdown_voltage) \
+    breakdown_voltage = (365.0 * pressure * gap) / (log(15.0 * pressure * gap) - log(log(1.0 + 1.0 / 0.01)));
 
 #endif /* CALCMACROS_H_ */
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Calculators.h"
+#include "CalcMacros.h"
+#include <limits>
 
 using namespace Calculators;
 
@@ -84,3 +86,121 @@ double PotentialCalulator::calcPotentialAtPoint(const double x, const double y,
 	
 	return static_cast< double >(potential);
 }
+
+std::vector< RingWire > PotentialCalulator::greatCircles(const double radius_mm)
+{
+	const double r = radius_mm / 1000;
+
+	return { { r, 0.0, 0.0, 1.0 }, { r, 1.0, 0.0, 0.0 }, { r, 0.0, 1.0, 0.0 } };
+}
+
+std::vector< RingWire > PotentialCalulator::spiralRings(const double radius_mm, const int count)
+{
+	if(count == 3)
+	{
+		return greatCircles(radius_mm);
+	}
+
+	const double r = radius_mm / 1000;
+	const double goldenAngle = PI_Macro * (3.0 - std::sqrt(5.0));
+
+	std::vector< RingWire > rings;
+
+	for(int k = 0; k < count; k++)
+	{
+		const double nz = 1.0 - (k + 0.5) / count;
+		const double ns = std::sqrt(std::max(0.0, 1.0 - nz * nz));
+		const double phi = k * goldenAngle;
+
+		rings.push_back({ r, ns * std::cos(phi), ns * std::sin(phi), nz });
+	}
+
+	return rings;
+}
+
+void PotentialCalulator::calcMinDistRow(const double x, const double y0, const double dy, const double z, const int count,
+										const RingWire *rings, const std::size_t ringCount, double *minDist)
+{
+	// A ring only sees a point through (rho, h) in its own frame, and rho^2 + h^2 = |p|^2 is the same for all rings.
+	// Among rings of one radius the nearest is therefore the one with the smallest |h|: the inner loop only needs
+	// h^2 per ring, the square roots are taken once per radius instead of once per ring.
+	const int block = 256;
+	double minH2[block];
+
+	const double px2 = x * x + z * z;
+
+	for(int i0 = 0; i0 < count; i0 += block)
+	{
+		const int n = std::min(block, count - i0);
+		const double yb = y0 + i0 * dy;
+
+		for(int i = 0; i < n; i++)
+		{
+			minDist[i0 + i] = std::numeric_limits< double >::max();
+		}
+
+		for(std::size_t g = 0; g < ringCount; g++)
+		{
+			const double radius = rings[g].radius;
+
+			// start of a radius group, rings of the same radius are gathered from the rest of the list
+			bool seen = false;
+			for(std::size_t w = 0; w < g && !seen; w++)
+			{
+				seen = rings[w].radius == radius;
+			}
+			if(seen)
+			{
+				continue;
+			}
+
+			for(int i = 0; i < n; i++)
+			{
+				minH2[i] = std::numeric_limits< double >::max();
+			}
+
+			// rings in the outer loop, so the inner loop runs over independent lanes without branches
+			for(std::size_t w = g; w < ringCount; w++)
+			{
+				const RingWire ring = rings[w];
+				if(ring.radius != radius)
+				{
+					continue;
+				}
+
+				const double hx = ring.nx * x + ring.nz * z;
+
+				for(int i = 0; i < n; i++)
+				{
+					const double h = hx + ring.ny * (yb + i * dy);
+					minH2[i] = std::min(minH2[i], h * h);
+				}
+			}
+
+			for(int i = 0; i < n; i++)
+			{
+				const double y = yb + i * dy;
+				const double rho = std::sqrt(std::max(px2 + y * y - minH2[i], 0.0));
+				const double d = rho - radius;
+
+				minDist[i0 + i] = std::min(minDist[i0 + i], d * d + minH2[i]);
+			}
+		}
+
+		for(int i = 0; i < n; i++)
+		{
+			minDist[i0 + i] = std::sqrt(minDist[i0 + i]);
+		}
+	}
+}
+
+void PotentialCalulator::calcPotentialRow(const double x, const double y0, const double dy, const double z, const int count,
+										  const std::vector< RingWire > &rings, const double kV, double *potential)
+{
+	calcMinDistRow(x, y0, dy, z, count, rings.data(), rings.size(), potential);
+
+	for(int i = 0; i < count; i++)
+	{
+		potential[i] = kV / potential[i];
+	}
+}
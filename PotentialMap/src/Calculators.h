@@ -4,6 +4,8 @@
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <cstddef>
+#include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/io.hpp>
@@ -11,6 +13,15 @@
 /// @brief Potential Calculation Utilities. \namespace Calculators
 namespace Calculators
 {
+    /// @brief A circular cathode wire centred on the origin. \struct RingWire
+    struct RingWire
+    {
+        double radius;
+        double nx;
+        double ny;
+        double nz;
+    };
+
     /// @brief Potential Calculation Utilities. \class PotentialCalulator
     class PotentialCalulator
     {
@@ -45,6 +56,50 @@ namespace Calculators
          */
         static double calcPotentialAtPoint(double x, double y, double z, double radius, double kV);
 
+        /**
+         * @brief The three orthogonal great circles of the classic cathode.
+         * @param radius_mm The ring radius in millimetres.
+         * @return Rings with their axes along z, x and y.
+         */
+        static std::vector< RingWire > greatCircles(double radius_mm);
+
+        /**
+         * @brief A cathode of great circles whose axes are spread over the upper hemisphere on a Fibonacci spiral.
+         * @param radius_mm The ring radius in millimetres.
+         * @param count The number of rings, e.g. 6 or 12.
+         * @return The rings, the three great circles for count 3.
+         */
+        static std::vector< RingWire > spiralRings(double radius_mm, int count);
+
+        /**
+         * @brief Distance from a row of points to the nearest ring, with stack-only double math the compiler can vectorise.
+         * Each ring is evaluated in its own (rho, h) frame; rings of equal radius share the square roots.
+         * @param x The x-coordinate of the row.
+         * @param y0 The y-coordinate of the first point.
+         * @param dy The y-spacing of the points.
+         * @param z The z-coordinate of the row.
+         * @param count The number of points.
+         * @param rings The rings.
+         * @param ringCount The number of rings.
+         * @param minDist Output, count distances in metres.
+         */
+        static void calcMinDistRow(double x, double y0, double dy, double z, int count,
+                                   const RingWire *rings, std::size_t ringCount, double *minDist);
+
+        /**
+         * @brief Electric potential along a row of points, kV / distance to the nearest ring.
+         * @param x The x-coordinate of the row.
+         * @param y0 The y-coordinate of the first point.
+         * @param dy The y-spacing of the points.
+         * @param z The z-coordinate of the row.
+         * @param count The number of points.
+         * @param rings The rings.
+         * @param kV The voltage of the rings.
+         * @param potential Output, count potentials.
+         */
+        static void calcPotentialRow(double x, double y0, double dy, double z, int count,
+                                     const std::vector< RingWire > &rings, double kV, double *potential);
+
         typedef boost::numeric::ublas::vector< long double > dVector;
 
         /**
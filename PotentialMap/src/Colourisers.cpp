@@ -216,3 +216,100 @@ double ColouriserCreator::QqhToRgb(const double q1, const double q2, double hue)
         return q1;
     }
 }
+
+namespace
+{
+	// entries per degree of hue, the HLS map changes by about one colour step per degree
+	const double hlsEntriesPerUnit = 64.0;
+
+	// colourise() only wraps the hue once, from here on all three channels sit at the lower level
+	const double hlsSpan = 841.0;
+
+	// one hue turn, the span of the other colour maps
+	const double mapSpan = 360.0;
+	const std::size_t mapEntries = 4096;
+
+	const PaletteEntry viridisStops[] = {
+		{ 68, 1, 84 }, { 71, 44, 122 }, { 59, 81, 139 }, { 44, 113, 142 }, { 33, 144, 141 },
+		{ 39, 173, 129 }, { 92, 200, 99 }, { 170, 220, 50 }, { 253, 231, 37 }
+	};
+}
+
+Palette::Palette(const Map map)
+{
+	if(map == Map::HLS)
+	{
+		m_span = hlsSpan;
+		m_scale = hlsEntriesPerUnit;
+		m_lut.resize(static_cast< std::size_t >(hlsSpan * hlsEntriesPerUnit) + 1);
+
+		for(std::size_t i = 0; i < m_lut.size(); i++)
+		{
+			int8_t r = 0;
+			int8_t g = 0;
+			int8_t b = 0;
+
+			ColouriserCreator::colourise(i / hlsEntriesPerUnit, 1.0, r, g, b);
+			m_lut[i] = { static_cast< uint8_t >(r), static_cast< uint8_t >(g), static_cast< uint8_t >(b) };
+		}
+	}
+	else
+	{
+		m_span = mapSpan;
+		m_scale = (mapEntries - 1) / mapSpan;
+		m_lut.resize(mapEntries);
+
+		const std::size_t stops = sizeof(viridisStops) / sizeof(viridisStops[0]);
+
+		for(std::size_t i = 0; i < mapEntries; i++)
+		{
+			const double t = static_cast< double >(i) / (mapEntries - 1);
+
+			if(map == Map::GREY)
+			{
+				const uint8_t v = static_cast< uint8_t >(t * 255.0);
+				m_lut[i] = { v, v, v };
+				continue;
+			}
+
+			const double pos = t * (stops - 1);
+			const std::size_t s0 = std::min(static_cast< std::size_t >(pos), stops - 2);
+			const double f = pos - s0;
+			const PaletteEntry &a = viridisStops[s0];
+			const PaletteEntry &c = viridisStops[s0 + 1];
+
+			m_lut[i] = { static_cast< uint8_t >(a.red + f * (c.red - a.red)),
+						 static_cast< uint8_t >(a.green + f * (c.green - a.green)),
+						 static_cast< uint8_t >(a.blue + f * (c.blue - a.blue)) };
+		}
+	}
+
+	m_last = static_cast< double >(m_lut.size() - 1);
+}
+
+bool Palette::fromName(const std::string &name, Map &map)
+{
+	if(name == "hls")
+	{
+		map = Map::HLS;
+	}
+	else if(name == "grey")
+	{
+		map = Map::GREY;
+	}
+	else if(name == "viridis")
+	{
+		map = Map::VIRIDIS;
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+double Palette::getSpan() const
+{
+	return m_span;
+}
@@ -2,8 +2,11 @@
 #define COLOURISERS_H
 
 #include <cmath>
+#include <cstddef>
 #include <stdint.h>
 #include <algorithm>
+#include <string>
+#include <vector>
 
 /// @brief Color Mapping Utilities. \namespace Colourisers
 namespace Colourisers
@@ -77,6 +80,65 @@ namespace Colourisers
          */
         static int8_t toBlue(double magnitude, double limit);
     };
+
+    /// @brief One colour of a palette. \struct PaletteEntry
+    struct PaletteEntry
+    {
+        uint8_t red;
+        uint8_t green;
+        uint8_t blue;
+    };
+
+    /// @brief Precomputed colour map, indexed by magnitude / limit as colourise() reads it. \class Palette
+    class Palette
+    {
+    public:
+        /// @brief The available colour maps. \enum Map
+        enum class Map
+        {
+            HLS,
+            GREY,
+            VIRIDIS
+        };
+
+        /**
+         * @brief Constructor for Palette, tabulates the colour map once.
+         * @param map The colour map. HLS reproduces colourise(); the others span normalised values 0 to 360.
+         */
+        explicit Palette(Map map = Map::HLS);
+
+        /**
+         * @brief Parse a colour map name.
+         * @param name hls, grey or viridis.
+         * @param map Output, the colour map.
+         * @return False for an unknown name.
+         */
+        static bool fromName(const std::string &name, Map &map);
+
+        /**
+         * @brief Colour of a normalised magnitude, values past the end of the table take its last colour.
+         * @param normalised magnitude / limit.
+         * @return The colour.
+         */
+        const PaletteEntry &lookup(const double normalised) const
+        {
+            const double x = normalised * m_scale;
+            const std::size_t index = x < m_last ? (x > 0.0 ? static_cast< std::size_t >(x) : 0) : m_lut.size() - 1;
+            return m_lut[index];
+        }
+
+        /**
+         * @brief Span of normalised values the colour map is drawn over, contour levels divide this span.
+         * @return The span.
+         */
+        double getSpan() const;
+
+    private:
+        std::vector< PaletteEntry > m_lut;
+        double m_scale;
+        double m_last;
+        double m_span;
+    };
 }
 
 #endif // COLOURISERS_H
@@ -0,0 +1,152 @@
+#include "DistanceField.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace Calculators;
+
+namespace
+{
+	/// @brief Header of a distance field file. \struct FieldHeader
+	struct FieldHeader
+	{
+		char magic[4];
+		int32_t version;
+		int32_t z_slices;
+		int32_t xy_slices;
+		int32_t axis_max;
+		int32_t radius;
+		int32_t ringCount;
+		int32_t rowLength;
+	};
+
+	const char fieldMagic[4] = { 'P', 'M', 'D', 'F' };
+	const int32_t fieldVersion = 1;
+}
+
+DistanceField::DistanceField(const MapGeometry &geometry)
+	: m_geometry(geometry)
+{
+}
+
+void DistanceField::compute()
+{
+	const int slices = m_geometry.sliceCount();
+	const int length = m_geometry.rowLength();
+	const std::vector< RingWire > rings = PotentialCalulator::spiralRings(m_geometry.radius, m_geometry.ringCount);
+
+	m_dist.assign(static_cast< std::size_t >(slices) * length * length, 0.0f);
+
+	std::atomic< int > nextSlice(0);
+
+	auto computeSlices = [&]()
+	{
+		std::vector< double > row(length);
+
+		for(int k = nextSlice++; k < slices; k = nextSlice++)
+		{
+			float *out = &m_dist[static_cast< std::size_t >(k) * length * length];
+
+			for(int x = 0; x < length; x++)
+			{
+				PotentialCalulator::calcMinDistRow(m_geometry.xyPos(x), 0.0, 2.0 * m_geometry.xySpace(), m_geometry.zPos(k),
+												   length, rings.data(), rings.size(), row.data());
+				std::copy(row.begin(), row.end(), out + static_cast< std::size_t >(x) * length);
+			}
+		}
+	};
+
+	const unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+	std::vector< std::thread > threads;
+	for(unsigned w = 0; w < workers; w++)
+	{
+		threads.emplace_back(computeSlices);
+	}
+
+	for(auto &t : threads)
+	{
+		t.join();
+	}
+}
+
+bool DistanceField::save(const std::string &fileName) const
+{
+	std::ofstream file(fileName, std::ios::binary);
+	if(!file)
+	{
+		return false;
+	}
+
+	FieldHeader header;
+	std::memcpy(header.magic, fieldMagic, sizeof(fieldMagic));
+	header.version = fieldVersion;
+	header.z_slices = m_geometry.z_slices;
+	header.xy_slices = m_geometry.xy_slices;
+	header.axis_max = m_geometry.axis_max;
+	header.radius = m_geometry.radius;
+	header.ringCount = m_geometry.ringCount;
+	header.rowLength = m_geometry.rowLength();
+
+	file.write(reinterpret_cast< const char * >(&header), sizeof(header));
+	file.write(reinterpret_cast< const char * >(m_dist.data()), static_cast< std::streamsize >(m_dist.size() * sizeof(float)));
+
+	return static_cast< bool >(file);
+}
+
+bool DistanceField::load(const std::string &fileName)
+{
+	std::ifstream file(fileName, std::ios::binary);
+	if(!file)
+	{
+		return false;
+	}
+
+	FieldHeader header;
+	if(!file.read(reinterpret_cast< char * >(&header), sizeof(header)))
+	{
+		return false;
+	}
+
+	// a field is only reused for the exact geometry and resolution it was made for
+	if(0 != std::memcmp(header.magic, fieldMagic, sizeof(fieldMagic)) || header.version != fieldVersion ||
+	   header.z_slices != m_geometry.z_slices || header.xy_slices != m_geometry.xy_slices ||
+	   header.axis_max != m_geometry.axis_max || header.radius != m_geometry.radius ||
+	   header.ringCount != m_geometry.ringCount || header.rowLength != m_geometry.rowLength())
+	{
+		return false;
+	}
+
+	const int length = m_geometry.rowLength();
+	m_dist.resize(static_cast< std::size_t >(m_geometry.sliceCount()) * length * length);
+
+	if(!file.read(reinterpret_cast< char * >(m_dist.data()), static_cast< std::streamsize >(m_dist.size() * sizeof(float))))
+	{
+		m_dist.clear();
+		return false;
+	}
+
+	return true;
+}
+
+std::string DistanceField::defaultFileName() const
+{
+	std::ostringstream name;
+	name << "distfield_z" << m_geometry.z_slices << "_xy" << m_geometry.xy_slices << "_a" << m_geometry.axis_max
+		 << "_r" << m_geometry.radius << "_n" << m_geometry.ringCount << ".bin";
+	return name.str();
+}
+
+const float *DistanceField::slice(const int k) const
+{
+	return &m_dist[static_cast< std::size_t >(k) * m_geometry.rowLength() * m_geometry.rowLength()];
+}
+
+const MapGeometry &DistanceField::getGeometry() const
+{
+	return m_geometry;
+}
@@ -0,0 +1,134 @@
+#if !defined(DISTANCEFIELD_H)
+#define DISTANCEFIELD_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Calculators.h"
+
+/// @brief Potential Calculation Utilities. \namespace Calculators
+namespace Calculators
+{
+    /// @brief Sampling of a potential map, shared by the direct renderer and the distance field. \struct MapGeometry
+    struct MapGeometry
+    {
+        int z_slices;
+        int xy_slices;
+        int axis_max;
+        int radius;
+        int ringCount;
+
+        /**
+         * @brief Spacing of the z-slices in metres (the axis size is given in mm).
+         * @return The spacing.
+         */
+        double zSpace() const
+        {
+            return (static_cast< double >(axis_max) / static_cast< double >(z_slices)) / 1000;
+        }
+
+        /**
+         * @brief Spacing of the pixels in metres.
+         * @return The spacing.
+         */
+        double xySpace() const
+        {
+            return (static_cast< double >(axis_max) / static_cast< double >(xy_slices)) / 1000;
+        }
+
+        /**
+         * @brief Number of slices from the centre plane up, the others are mirrored.
+         * @return The number of computed slices.
+         */
+        int sliceCount() const
+        {
+            return z_slices - z_slices / 2;
+        }
+
+        /**
+         * @brief Number of computed pixels along x and y, one quadrant of the slice.
+         * @return The row length.
+         */
+        int rowLength() const
+        {
+            const int xy_half = xy_slices / 2;
+            return xy_half + (xy_half % 2);
+        }
+
+        /**
+         * @brief Position of a computed slice, each index advances two spacings as in the original renderer.
+         * @param k Slice index from the centre plane.
+         * @return The z-position in metres.
+         */
+        double zPos(int k) const
+        {
+            return 2.0 * k * zSpace();
+        }
+
+        /**
+         * @brief Position of a computed pixel along x or y.
+         * @param i Pixel index from the centre.
+         * @return The position in metres.
+         */
+        double xyPos(int i) const
+        {
+            return 2.0 * i * xySpace();
+        }
+    };
+
+    /// @brief Voltage-independent distance to the nearest cathode ring, for one geometry and resolution. \class DistanceField
+    class DistanceField
+    {
+    public:
+        /**
+         * @brief Constructor for DistanceField, the field is empty until computed or loaded.
+         * @param geometry The geometry and sampling.
+         */
+        explicit DistanceField(const MapGeometry &geometry);
+
+        /**
+         * @brief Compute the field with the row kernel, slices spread over all hardware threads.
+         */
+        void compute();
+
+        /**
+         * @brief Write the field as a binary volume: a header with the geometry, then float32 distances.
+         * @param fileName The file name.
+         * @return True on success.
+         */
+        bool save(const std::string &fileName) const;
+
+        /**
+         * @brief Read a field written by save().
+         * @param fileName The file name.
+         * @return True if the file exists and was made for the same geometry.
+         */
+        bool load(const std::string &fileName);
+
+        /**
+         * @brief Default file name, unique per geometry and resolution.
+         * @return The file name.
+         */
+        std::string defaultFileName() const;
+
+        /**
+         * @brief Distances of one slice.
+         * @param k Slice index from the centre plane.
+         * @return rowLength * rowLength distances in metres, x major.
+         */
+        const float *slice(int k) const;
+
+        /**
+         * @brief Getter for the geometry.
+         * @return The geometry.
+         */
+        const MapGeometry &getGeometry() const;
+
+    private:
+        MapGeometry m_geometry;
+        std::vector< float > m_dist;
+    };
+}
+
+#endif // DISTANCEFIELD_H
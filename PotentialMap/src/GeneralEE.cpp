@@ -1,4 +1,9 @@
 #include "GeneralEE.h"
+#include "Colourisers.h"
+
+#include <atomic>
+#include <iomanip>
+#include <thread>
 
 using namespace GeneralEE;
 using namespace std;
@@ -80,6 +85,193 @@ void ElectricalEngineering::calculateChamberParameters(const std::string& filena
     cout << "---------------------------------------" << endl;
 }
 
+ChamberSweep::ChamberSweep(const ChamberGrid& grid)
+    : grid_(grid)
+{
+}
+
+void ChamberSweep::run(unsigned threads)
+{
+    const size_t points = grid_.size();
+    const size_t rowLength = grid_.pressures.size();
+
+    density_.assign(points, 0.0);
+    meanFreePath_.assign(points, 0.0);
+    vacuumPermittivity_.assign(points, 0.0);
+    energyJ_.assign(points, 0.0);
+    breakdownVoltage_.assign(points, 0.0);
+
+    if (points == 0)
+        return;
+
+    // one row per (gap, temperature, energy), the pressures run along it
+    const size_t rows = points / rowLength;
+    const size_t gaps = grid_.gaps.size();
+    const size_t temperatures = grid_.temperatures.size();
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, rows));
+
+    std::atomic<size_t> nextRow(0);
+
+    auto evaluateRows = [&]()
+    {
+        const double cross_section = grid_.cross_section;
+
+        for (size_t row = nextRow++; row < rows; row = nextRow++)
+        {
+            const double gap = grid_.gaps[row % gaps];
+            const double temperature = grid_.temperatures[(row / gaps) % temperatures];
+            const double energy = grid_.energies[row / (gaps * temperatures)];
+
+            double energy_J;
+            eV2J(energy, energy_J);
+
+            const double* pressure = grid_.pressures.data();
+            double* density = density_.data() + row * rowLength;
+            double* mean_free_path = meanFreePath_.data() + row * rowLength;
+            double* vacuum_permittivity = vacuumPermittivity_.data() + row * rowLength;
+            double* energyJ = energyJ_.data() + row * rowLength;
+            double* breakdown_voltage = breakdownVoltage_.data() + row * rowLength;
+
+            // same formulas as calculateChamberParameters, over independent lanes
+            for (size_t i = 0; i < rowLength; i++)
+            {
+                DENSITY(pressure[i], temperature, density[i]);
+                MEAN_FREE_PATH(density[i], cross_section, mean_free_path[i]);
+                VACUUM_PERMITTIVITY(mean_free_path[i], vacuum_permittivity[i]);
+                PASCHEN_BREAKDOWN(pressure[i], gap, breakdown_voltage[i]);
+                energyJ[i] = energy_J;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+        workers.emplace_back(evaluateRows);
+
+    evaluateRows();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+bool ChamberSweep::writeCsv(const std::string& filename) const
+{
+    ofstream file(filename);
+    if (!file)
+        return false;
+
+    const size_t rowLength = grid_.pressures.size();
+    const size_t gaps = grid_.gaps.size();
+    const size_t temperatures = grid_.temperatures.size();
+
+    file << std::setprecision(10);
+    file << "pressure,gap,temperature,energy_eV,density,mean_free_path,vacuum_permittivity,energy_J,breakdown_voltage\n";
+
+    for (size_t i = 0; i < density_.size(); i++)
+    {
+        const size_t row = i / rowLength;
+
+        file << grid_.pressures[i % rowLength] << ','
+             << grid_.gaps[row % gaps] << ','
+             << grid_.temperatures[(row / gaps) % temperatures] << ','
+             << grid_.energies[row / (gaps * temperatures)] << ','
+             << density_[i] << ','
+             << meanFreePath_[i] << ','
+             << vacuumPermittivity_[i] << ','
+             << energyJ_[i] << ','
+             << breakdownVoltage_[i] << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool ChamberSweep::writeHeatMap(const std::string& filename) const
+{
+    const int columns = static_cast<int>(grid_.pressures.size());
+    const int rows = static_cast<int>(grid_.gaps.size());
+
+    if (columns == 0 || rows == 0 || breakdownVoltage_.empty())
+        return false;
+
+    // the first temperature and energy, the breakdown voltage depends on pressure and gap only
+    auto voltage = [&](const int p, const int g) { return breakdownVoltage_[static_cast<size_t>(g) * columns + p]; };
+
+    double low = std::numeric_limits<double>::max();
+    double high = std::numeric_limits<double>::lowest();
+
+    for (int g = 0; g < rows; g++)
+    {
+        for (int p = 0; p < columns; p++)
+        {
+            const double v = voltage(p, g);
+            if (v > 0.0 && std::isfinite(v))
+            {
+                low = std::min(low, std::log10(v));
+                high = std::max(high, std::log10(v));
+            }
+        }
+    }
+
+    // small grids are blown up to the size of the single-point image
+    const int cell = std::max(1, 400 / std::max(columns, rows));
+    const Colourisers::Palette palette(Colourisers::Palette::Map::VIRIDIS);
+    const double scale = high > low ? palette.getSpan() / (high - low) : 0.0;
+
+    gil::rgb8_image_t img(columns * cell, rows * cell);
+    const gil::rgb8_view_t view = gil::view(img);
+
+    for (int y = 0; y < view.height(); y++)
+    {
+        const int g = rows - 1 - y / cell;
+        auto row = view.row_begin(y);
+
+        for (int x = 0; x < view.width(); x++)
+        {
+            const double v = voltage(x / cell, g);
+
+            if (v > 0.0 && std::isfinite(v))
+            {
+                const Colourisers::PaletteEntry& colour = palette.lookup((std::log10(v) - low) * scale);
+                row[x] = gil::rgb8_pixel_t(colour.red, colour.green, colour.blue);
+            }
+            else
+            {
+                row[x] = gil::rgb8_pixel_t(0, 0, 0);
+            }
+        }
+    }
+
+    try
+    {
+        gil::write_view(filename, gil::const_view(img), gil::png_tag());
+    }
+    catch (const std::exception& ex)
+    {
+        cout << "Unable to write " << filename << endl << ex.what() << endl;
+        return false;
+    }
+
+    return true;
+}
+
+const std::vector<double>& ChamberSweep::getDensity() const
+{
+    return density_;
+}
+
+const std::vector<double>& ChamberSweep::getMeanFreePath() const
+{
+    return meanFreePath_;
+}
+
+const std::vector<double>& ChamberSweep::getBreakdownVoltage() const
+{
+    return breakdownVoltage_;
+}
+
 HighVoltagePowerSupply::HighVoltagePowerSupply(double initialPrimaryVoltage, double initialFusorImpedance)
     : primaryVoltage(initialPrimaryVoltage)
     , secondaryVoltage(0.0)
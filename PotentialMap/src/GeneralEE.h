@@ -2,6 +2,8 @@
 #define GENERAL_EE_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 #include <boost/mpl/vector.hpp>
 #include <boost/gil/typedefs.hpp>
 #include <boost/gil/image.hpp>
@@ -45,6 +47,84 @@ namespace GeneralEE
         static void drawLine(const gil::rgb8_view_t &img, int x1, int y1, int x2, int y2, const gil::rgb8_pixel_t &color);
     };
 
+    /// @brief Axes of a chamber sweep, every combination is one point. \struct ChamberGrid
+    struct ChamberGrid
+    {
+        std::vector<double> pressures;
+        std::vector<double> gaps;
+        std::vector<double> temperatures;
+        std::vector<double> energies;
+        double cross_section;
+
+        /**
+         * @brief Number of points.
+         * @return The product of the axis lengths.
+         */
+        std::size_t size() const
+        {
+            return pressures.size() * gaps.size() * temperatures.size() * energies.size();
+        }
+    };
+
+    /// @brief Chamber parameters and Paschen breakdown over a whole grid, evaluated on all cores. \class ChamberSweep
+    class ChamberSweep
+    {
+    public:
+
+        /**
+         * @brief Constructor for ChamberSweep, nothing is evaluated yet.
+         * @param grid The axes. Points are stored with the pressure varying fastest, then gap, temperature and energy.
+         */
+        explicit ChamberSweep(const ChamberGrid& grid);
+
+        /**
+         * @brief Evaluate every point. Each thread takes whole pressure rows, which are plain loops over contiguous arrays.
+         * @param threads Number of threads, 0 for one per core.
+         */
+        void run(unsigned threads = 0);
+
+        /**
+         * @brief Write one line per point: the inputs, density, mean free path, vacuum permittivity, energy in J and breakdown voltage.
+         * @param filename The output filename.
+         * @return True on success.
+         */
+        bool writeCsv(const std::string& filename) const;
+
+        /**
+         * @brief Write the breakdown voltage over pressure (left to right) and gap (bottom to top) as a heat map, log scaled.
+         * It does not depend on temperature or energy. Points without breakdown are black.
+         * @param filename The output filename.
+         * @return True on success.
+         */
+        bool writeHeatMap(const std::string& filename) const;
+
+        /**
+         * @brief Getter for the density of every point.
+         * @return The densities in kg/m^3, in grid order.
+         */
+        const std::vector<double>& getDensity() const;
+
+        /**
+         * @brief Getter for the mean free path of every point.
+         * @return The mean free paths in m, in grid order.
+         */
+        const std::vector<double>& getMeanFreePath() const;
+
+        /**
+         * @brief Getter for the Paschen breakdown voltage of every point.
+         * @return The voltages in V, not positive where the gap does not break down, in grid order.
+         */
+        const std::vector<double>& getBreakdownVoltage() const;
+
+    private:
+        ChamberGrid grid_;
+        std::vector<double> density_;
+        std::vector<double> meanFreePath_;
+        std::vector<double> vacuumPermittivity_;
+        std::vector<double> energyJ_;
+        std::vector<double> breakdownVoltage_;
+    };
+
     /// @brief High Voltage Power Supply Simulation. \class HighVoltagePowerSupply
     class HighVoltagePowerSupply
     {
@@ -0,0 +1,510 @@
+#include "LaplaceSolver.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+using namespace Calculators;
+
+namespace
+{
+	// rows of a plane handled together, three planes of such a block stay in cache while the sweep moves along z
+	const int blockRows = 16;
+
+	// levels below this size run on the calling thread, spawning costs more than the sweep
+	const int parallelCells = 32;
+
+	inline std::size_t index(const int nodes, const int i, const int j, const int k)
+	{
+		return (static_cast< std::size_t >(k) * nodes + j) * nodes + i;
+	}
+
+	// legacy VTK binary data is big-endian whatever the host is
+	inline uint32_t toBigEndian(const float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		unsigned char bytes[4] = { static_cast< unsigned char >(bits >> 24), static_cast< unsigned char >(bits >> 16),
+								   static_cast< unsigned char >(bits >> 8), static_cast< unsigned char >(bits) };
+		std::memcpy(&bits, bytes, sizeof(bits));
+		return bits;
+	}
+}
+
+LaplaceSolver::LaplaceSolver(const int cells, const double halfExtent)
+	: m_halfExtent(halfExtent)
+	, m_spacing(2.0 * halfExtent / cells)
+	, m_omega(1.6)
+	, m_residual(1.0)
+	, m_threads(std::max(1u, std::thread::hardware_concurrency()))
+{
+	// coarsen down to four cells per edge, the coarsest grid is then solved by plain sweeps
+	for(int n = cells; ; n /= 2)
+	{
+		Level level;
+		level.cells = n;
+		level.h2 = (2.0 * halfExtent / n) * (2.0 * halfExtent / n);
+
+		const std::size_t size = static_cast< std::size_t >(n + 1) * (n + 1) * (n + 1);
+		level.u.assign(size, 0.0f);
+		level.r.assign(size, 0.0f);
+		level.fixed.assign(size, 0);
+
+		// Laplace's equation has no source, only the correction equations of the coarse levels have one
+		if(!m_levels.empty())
+		{
+			level.f.assign(size, 0.0f);
+		}
+
+		m_levels.push_back(std::move(level));
+
+		if(n % 2 != 0 || n / 2 < 4)
+		{
+			break;
+		}
+	}
+}
+
+void LaplaceSolver::setBoundaries(const std::vector< RingWire > &rings, const double cathode, const double anodeRadius)
+{
+	Level &fine = m_levels.front();
+	const int n = fine.cells;
+	const int nodes = n + 1;
+	const double onWire = 0.5 * std::sqrt(3.0) * m_spacing;
+
+	// every point of a wire lies within half a voxel diagonal of a node, so the voxelised ring stays closed
+	parallelPlanes(0, nodes, n, [&](const int kBegin, const int kEnd, unsigned)
+	{
+		std::vector< double > dist(nodes);
+
+		for(int k = kBegin; k < kEnd; k++)
+		{
+			const double z = -m_halfExtent + k * m_spacing;
+
+			for(int i = 0; i < nodes; i++)
+			{
+				const double x = -m_halfExtent + i * m_spacing;
+				PotentialCalulator::calcMinDistRow(x, -m_halfExtent, m_spacing, z, nodes, rings.data(), rings.size(), dist.data());
+
+				for(int j = 0; j < nodes; j++)
+				{
+					const double y = -m_halfExtent + j * m_spacing;
+					const std::size_t idx = index(nodes, i, j, k);
+					const bool face = i == 0 || j == 0 || k == 0 || i == n || j == n || k == n;
+
+					if(dist[j] <= onWire)
+					{
+						fine.u[idx] = static_cast< float >(cathode);
+						fine.fixed[idx] = 1;
+					}
+					else if(face || x * x + y * y + z * z >= anodeRadius * anodeRadius)
+					{
+						fine.u[idx] = 0.0f;
+						fine.fixed[idx] = 1;
+					}
+					else
+					{
+						fine.u[idx] = 0.0f;
+						fine.fixed[idx] = 0;
+					}
+				}
+			}
+		}
+	});
+
+	// a coarse node is fixed when any fine node it covers is, its correction is then held at zero
+	for(std::size_t l = 1; l < m_levels.size(); l++)
+	{
+		const Level &finer = m_levels[l - 1];
+		Level &coarse = m_levels[l];
+		const int nc = coarse.cells;
+		const int fineNodes = finer.cells + 1;
+
+		for(int k = 0; k <= nc; k++)
+		{
+			for(int j = 0; j <= nc; j++)
+			{
+				for(int i = 0; i <= nc; i++)
+				{
+					uint8_t isFixed = (i == 0 || j == 0 || k == 0 || i == nc || j == nc || k == nc) ? 1 : 0;
+
+					for(int dk = -1; dk <= 1 && !isFixed; dk++)
+					{
+						for(int dj = -1; dj <= 1 && !isFixed; dj++)
+						{
+							for(int di = -1; di <= 1 && !isFixed; di++)
+							{
+								isFixed = finer.fixed[index(fineNodes, 2 * i + di, 2 * j + dj, 2 * k + dk)];
+							}
+						}
+					}
+
+					coarse.fixed[index(nc + 1, i, j, k)] = isFixed;
+				}
+			}
+		}
+	}
+}
+
+int LaplaceSolver::solve(const double tolerance, const int maxCycles)
+{
+	const double initial = residual(m_levels.front());
+	m_residual = 1.0;
+
+	if(0.0 == initial)
+	{
+		return 0;
+	}
+
+	int cycles = 0;
+
+	while(cycles < maxCycles && m_residual > tolerance)
+	{
+		vCycle(0);
+		cycles++;
+
+		m_residual = residual(m_levels.front()) / initial;
+	}
+
+	return cycles;
+}
+
+double LaplaceSolver::sample(const double x, const double y, const double z) const
+{
+	const Level &fine = m_levels.front();
+	const int n = fine.cells;
+	const int nodes = n + 1;
+
+	auto cell = [&](const double p, int &c, double &t)
+	{
+		const double g = std::min(std::max((p + m_halfExtent) / m_spacing, 0.0), static_cast< double >(n));
+		c = std::min(static_cast< int >(g), n - 1);
+		t = g - c;
+	};
+
+	int i, j, k;
+	double tx, ty, tz;
+	cell(x, i, tx);
+	cell(y, j, ty);
+	cell(z, k, tz);
+
+	double value = 0.0;
+
+	for(int dk = 0; dk < 2; dk++)
+	{
+		for(int dj = 0; dj < 2; dj++)
+		{
+			for(int di = 0; di < 2; di++)
+			{
+				const double w = (di ? tx : 1.0 - tx) * (dj ? ty : 1.0 - ty) * (dk ? tz : 1.0 - tz);
+				value += w * fine.u[index(nodes, i + di, j + dj, k + dk)];
+			}
+		}
+	}
+
+	return value;
+}
+
+bool LaplaceSolver::save(const std::string &fileName, const double cathode) const
+{
+	std::ofstream file(fileName, std::ios::binary);
+	if(!file)
+	{
+		return false;
+	}
+
+	const Level &fine = m_levels.front();
+	const int nodes = fine.cells + 1;
+
+	file << std::setprecision(9)
+		 << "# vtk DataFile Version 3.0\n"
+		 << "PotentialMap potential, cathode " << cathode << " V\n"
+		 << "BINARY\n"
+		 << "DATASET STRUCTURED_POINTS\n"
+		 << "DIMENSIONS " << nodes << " " << nodes << " " << nodes << "\n"
+		 << "ORIGIN " << -m_halfExtent << " " << -m_halfExtent << " " << -m_halfExtent << "\n"
+		 << "SPACING " << m_spacing << " " << m_spacing << " " << m_spacing << "\n"
+		 << "POINT_DATA " << fine.u.size() << "\n"
+		 << "SCALARS potential float 1\n"
+		 << "LOOKUP_TABLE default\n";
+
+	std::vector< uint32_t > chunk;
+	const std::size_t chunkSize = 1 << 16;
+
+	for(std::size_t first = 0; first < fine.u.size(); first += chunkSize)
+	{
+		const std::size_t count = std::min(chunkSize, fine.u.size() - first);
+		chunk.resize(count);
+
+		for(std::size_t v = 0; v < count; v++)
+		{
+			chunk[v] = toBigEndian(fine.u[first + v]);
+		}
+
+		file.write(reinterpret_cast< const char * >(chunk.data()), static_cast< std::streamsize >(count * sizeof(uint32_t)));
+	}
+
+	return static_cast< bool >(file);
+}
+
+void LaplaceSolver::setRelaxation(const double omega)
+{
+	m_omega = omega;
+}
+
+double LaplaceSolver::getResidual() const
+{
+	return m_residual;
+}
+
+int LaplaceSolver::getNodes() const
+{
+	return m_levels.front().cells + 1;
+}
+
+std::size_t LaplaceSolver::getLevelCount() const
+{
+	return m_levels.size();
+}
+
+void LaplaceSolver::smooth(Level &level, const int sweeps) const
+{
+	const int n = level.cells;
+	const int nodes = n + 1;
+	const std::size_t plane = static_cast< std::size_t >(nodes) * nodes;
+	const float omega = static_cast< float >(m_omega);
+	const float h2 = static_cast< float >(level.h2);
+	const float sixth = 1.0f / 6.0f;
+
+	float *u = level.u.data();
+	const float *f = level.f.empty() ? nullptr : level.f.data();
+	const uint8_t *fixed = level.fixed.data();
+
+	for(int s = 0; s < sweeps; s++)
+	{
+		// all nodes of one colour only read nodes of the other, so the planes can be split freely between threads
+		for(int colour = 0; colour < 2; colour++)
+		{
+			parallelPlanes(1, n, n, [&](const int kBegin, const int kEnd, unsigned)
+			{
+				for(int jb = 1; jb < n; jb += blockRows)
+				{
+					const int jEnd = std::min(jb + blockRows, n);
+
+					for(int k = kBegin; k < kEnd; k++)
+					{
+						for(int j = jb; j < jEnd; j++)
+						{
+							const int iStart = 1 + ((1 + j + k + colour) & 1);
+
+							for(int i = iStart; i < n; i += 2)
+							{
+								const std::size_t idx = index(nodes, i, j, k);
+								if(fixed[idx])
+								{
+									continue;
+								}
+
+								float sum = u[idx - 1] + u[idx + 1] + u[idx - nodes] + u[idx + nodes] + u[idx - plane] + u[idx + plane];
+								if(f)
+								{
+									sum += h2 * f[idx];
+								}
+
+								u[idx] += omega * (sum * sixth - u[idx]);
+							}
+						}
+					}
+				}
+			});
+		}
+	}
+}
+
+double LaplaceSolver::residual(Level &level) const
+{
+	const int n = level.cells;
+	const int nodes = n + 1;
+	const std::size_t plane = static_cast< std::size_t >(nodes) * nodes;
+	const float invH2 = static_cast< float >(1.0 / level.h2);
+
+	const float *u = level.u.data();
+	const float *f = level.f.empty() ? nullptr : level.f.data();
+	const uint8_t *fixed = level.fixed.data();
+	float *r = level.r.data();
+
+	std::vector< double > partial(m_threads, 0.0);
+
+	parallelPlanes(1, n, n, [&](const int kBegin, const int kEnd, const unsigned worker)
+	{
+		double sum2 = 0.0;
+
+		for(int k = kBegin; k < kEnd; k++)
+		{
+			for(int j = 1; j < n; j++)
+			{
+				for(int i = 1; i < n; i++)
+				{
+					const std::size_t idx = index(nodes, i, j, k);
+
+					float res = 0.0f;
+					if(!fixed[idx])
+					{
+						const float lap = u[idx - 1] + u[idx + 1] + u[idx - nodes] + u[idx + nodes] + u[idx - plane] + u[idx + plane] - 6.0f * u[idx];
+						res = (f ? f[idx] : 0.0f) + lap * invH2;
+					}
+
+					r[idx] = res;
+					sum2 += static_cast< double >(res) * res;
+				}
+			}
+		}
+
+		partial[worker] += sum2;
+	});
+
+	double total = 0.0;
+	for(const double p : partial)
+	{
+		total += p;
+	}
+
+	return std::sqrt(total);
+}
+
+void LaplaceSolver::restrictResidual(const Level &fine, Level &coarse) const
+{
+	const int nc = coarse.cells;
+	const int coarseNodes = nc + 1;
+	const int fineNodes = fine.cells + 1;
+
+	// full weighting, 1/8 scaled by 1/2 per offset axis
+	parallelPlanes(1, nc, nc, [&](const int kBegin, const int kEnd, unsigned)
+	{
+		for(int k = kBegin; k < kEnd; k++)
+		{
+			for(int j = 1; j < nc; j++)
+			{
+				for(int i = 1; i < nc; i++)
+				{
+					const std::size_t idx = index(coarseNodes, i, j, k);
+					coarse.u[idx] = 0.0f;
+
+					if(coarse.fixed[idx])
+					{
+						coarse.f[idx] = 0.0f;
+						continue;
+					}
+
+					float sum = 0.0f;
+					for(int dk = -1; dk <= 1; dk++)
+					{
+						for(int dj = -1; dj <= 1; dj++)
+						{
+							for(int di = -1; di <= 1; di++)
+							{
+								const int offAxes = (di != 0) + (dj != 0) + (dk != 0);
+								sum += fine.r[index(fineNodes, 2 * i + di, 2 * j + dj, 2 * k + dk)] / static_cast< float >(1 << offAxes);
+							}
+						}
+					}
+
+					coarse.f[idx] = 0.125f * sum;
+				}
+			}
+		}
+	});
+}
+
+void LaplaceSolver::prolongateCorrection(const Level &coarse, Level &fine) const
+{
+	const int n = fine.cells;
+	const int fineNodes = n + 1;
+	const int coarseNodes = coarse.cells + 1;
+
+	// trilinear, an even fine index sits on a coarse node and counts that node twice at half weight
+	parallelPlanes(1, n, n, [&](const int kBegin, const int kEnd, unsigned)
+	{
+		for(int k = kBegin; k < kEnd; k++)
+		{
+			const int k0 = k >> 1;
+			const int k1 = k0 + (k & 1);
+
+			for(int j = 1; j < n; j++)
+			{
+				const int j0 = j >> 1;
+				const int j1 = j0 + (j & 1);
+
+				for(int i = 1; i < n; i++)
+				{
+					const std::size_t idx = index(fineNodes, i, j, k);
+					if(fine.fixed[idx])
+					{
+						continue;
+					}
+
+					const int i0 = i >> 1;
+					const int i1 = i0 + (i & 1);
+
+					const float e = coarse.u[index(coarseNodes, i0, j0, k0)] + coarse.u[index(coarseNodes, i1, j0, k0)]
+								  + coarse.u[index(coarseNodes, i0, j1, k0)] + coarse.u[index(coarseNodes, i1, j1, k0)]
+								  + coarse.u[index(coarseNodes, i0, j0, k1)] + coarse.u[index(coarseNodes, i1, j0, k1)]
+								  + coarse.u[index(coarseNodes, i0, j1, k1)] + coarse.u[index(coarseNodes, i1, j1, k1)];
+
+					fine.u[idx] += 0.125f * e;
+				}
+			}
+		}
+	});
+}
+
+void LaplaceSolver::vCycle(const std::size_t l)
+{
+	Level &level = m_levels[l];
+
+	if(l + 1 == m_levels.size())
+	{
+		smooth(level, 4 * level.cells);
+		return;
+	}
+
+	smooth(level, 2);
+	residual(level);
+
+	Level &coarse = m_levels[l + 1];
+	restrictResidual(level, coarse);
+	vCycle(l + 1);
+	prolongateCorrection(coarse, level);
+
+	smooth(level, 2);
+}
+
+void LaplaceSolver::parallelPlanes(const int begin, const int end, const int cells, const std::function< void(int, int, unsigned) > &body) const
+{
+	if(m_threads == 1 || cells < parallelCells)
+	{
+		body(begin, end, 0);
+		return;
+	}
+
+	const int count = end - begin;
+	std::vector< std::thread > threads;
+
+	for(unsigned w = 0; w < m_threads; w++)
+	{
+		const int kBegin = begin + static_cast< int >(static_cast< long long >(count) * w / m_threads);
+		const int kEnd = begin + static_cast< int >(static_cast< long long >(count) * (w + 1) / m_threads);
+
+		if(kBegin < kEnd)
+		{
+			threads.emplace_back(body, kBegin, kEnd, w);
+		}
+	}
+
+	for(auto &t : threads)
+	{
+		t.join();
+	}
+}
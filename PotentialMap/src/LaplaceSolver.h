@@ -0,0 +1,112 @@
+#if !defined(LAPLACESOLVER_H)
+#define LAPLACESOLVER_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Calculators.h"
+
+/// @brief Potential Calculation Utilities. \namespace Calculators
+namespace Calculators
+{
+    /// @brief Finite-difference solution of Laplace's equation between the cathode rings and a spherical anode. \class LaplaceSolver
+    class LaplaceSolver
+    {
+    public:
+        /**
+         * @brief Constructor for LaplaceSolver, a cube of cells^3 voxels centred on the origin.
+         * @param cells Cells per edge, a power of two of at least 8.
+         * @param halfExtent Half the edge length of the cube in metres.
+         */
+        LaplaceSolver(int cells, double halfExtent);
+
+        /**
+         * @brief Voxelise the Dirichlet boundaries: every node within half a voxel diagonal of a ring is cathode,
+         * every node on or outside the anode sphere and on the faces of the cube is grounded.
+         * @param rings The cathode rings.
+         * @param cathode The cathode potential in volts.
+         * @param anodeRadius The anode radius in metres.
+         */
+        void setBoundaries(const std::vector< RingWire > &rings, double cathode, double anodeRadius);
+
+        /**
+         * @brief Multigrid V-cycles with a red-black SOR smoother until the residual has dropped by the tolerance.
+         * @param tolerance Residual reduction, relative to the residual of the initial guess.
+         * @param maxCycles Maximum number of V-cycles.
+         * @return The number of V-cycles run.
+         */
+        int solve(double tolerance, int maxCycles);
+
+        /**
+         * @brief Potential at a point, trilinear between the nodes and clamped to the cube.
+         * @param x The x-coordinate in metres.
+         * @param y The y-coordinate in metres.
+         * @param z The z-coordinate in metres.
+         * @return The potential in volts.
+         */
+        double sample(double x, double y, double z) const;
+
+        /**
+         * @brief Write the potential as a legacy VTK structured-points volume, binary float32 node values, x fastest.
+         * Origin and spacing are in metres; the title line records the cathode potential the map was solved for.
+         * @param fileName The file name, conventionally *.vtk.
+         * @param cathode The cathode potential in volts, as passed to setBoundaries().
+         * @return True on success.
+         */
+        bool save(const std::string &fileName, double cathode) const;
+
+        /**
+         * @brief Setter for the over-relaxation factor of the smoother.
+         * @param omega The factor, 1 is plain Gauss-Seidel, default 1.6.
+         */
+        void setRelaxation(double omega);
+
+        /**
+         * @brief Getter for the residual reduction reached by the last solve().
+         * @return The L2 norm of the residual relative to the initial one.
+         */
+        double getResidual() const;
+
+        /**
+         * @brief Getter for the number of nodes per edge.
+         * @return cells + 1.
+         */
+        int getNodes() const;
+
+        /**
+         * @brief Getter for the number of multigrid levels.
+         * @return The level count, the finest included.
+         */
+        std::size_t getLevelCount() const;
+
+    private:
+        /// @brief One grid of the hierarchy. \struct Level
+        struct Level
+        {
+            int cells;
+            double h2;
+            std::vector< float > u;
+            std::vector< float > f;
+            std::vector< float > r;
+            std::vector< uint8_t > fixed;
+        };
+
+        void smooth(Level &level, int sweeps) const;
+        double residual(Level &level) const;
+        void restrictResidual(const Level &fine, Level &coarse) const;
+        void prolongateCorrection(const Level &coarse, Level &fine) const;
+        void vCycle(std::size_t l);
+        void parallelPlanes(int begin, int end, int cells, const std::function< void(int, int, unsigned) > &body) const;
+
+        std::vector< Level > m_levels;
+        double m_halfExtent;
+        double m_spacing;
+        double m_omega;
+        double m_residual;
+        unsigned m_threads;
+    };
+}
+
+#endif // LAPLACESOLVER_H
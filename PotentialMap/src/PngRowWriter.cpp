@@ -0,0 +1,104 @@
+#include "PngRowWriter.h"
+
+using namespace Pipeline;
+
+PngRowWriter::PngRowWriter()
+	: m_file(nullptr)
+	, m_png(nullptr)
+	, m_info(nullptr)
+{
+}
+
+PngRowWriter::~PngRowWriter()
+{
+	release();
+}
+
+bool PngRowWriter::open(const std::string &fileName, const int width, const int height)
+{
+	release();
+
+	m_file = std::fopen(fileName.c_str(), "wb");
+	if(!m_file)
+	{
+		return false;
+	}
+
+	m_png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	m_info = m_png ? png_create_info_struct(m_png) : nullptr;
+	if(!m_info)
+	{
+		release();
+		return false;
+	}
+
+	// libpng reports errors by jumping back here
+	if(setjmp(png_jmpbuf(m_png)))
+	{
+		release();
+		return false;
+	}
+
+	png_init_io(m_png, m_file);
+	png_set_IHDR(m_png, m_info, static_cast< png_uint_32 >(width), static_cast< png_uint_32 >(height), 8, PNG_COLOR_TYPE_RGB,
+				 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+	png_write_info(m_png, m_info);
+
+	return true;
+}
+
+bool PngRowWriter::writeRow(const unsigned char *rgb)
+{
+	if(!m_png)
+	{
+		return false;
+	}
+
+	if(setjmp(png_jmpbuf(m_png)))
+	{
+		release();
+		return false;
+	}
+
+	png_write_row(m_png, rgb);
+	return true;
+}
+
+bool PngRowWriter::close()
+{
+	if(!m_png)
+	{
+		return false;
+	}
+
+	if(setjmp(png_jmpbuf(m_png)))
+	{
+		release();
+		return false;
+	}
+
+	png_write_end(m_png, m_info);
+	png_destroy_write_struct(&m_png, &m_info);
+
+	const bool closed = 0 == std::fclose(m_file);
+	m_file = nullptr;
+
+	return closed;
+}
+
+void PngRowWriter::release()
+{
+	if(m_png)
+	{
+		png_destroy_write_struct(&m_png, m_info ? &m_info : nullptr);
+	}
+
+	if(m_file)
+	{
+		std::fclose(m_file);
+	}
+
+	m_file = nullptr;
+	m_png = nullptr;
+	m_info = nullptr;
+}
@@ -0,0 +1,60 @@
+#if !defined(PNGROWWRITER_H)
+#define PNGROWWRITER_H
+
+#include <cstdio>
+#include <string>
+
+#include <png.h>
+
+/// @brief Slice rendering pipeline: work queue, slice driver and PNG output. \namespace Pipeline
+namespace Pipeline
+{
+    /// @brief Writes an 8-bit RGB PNG row by row, so no image has to be held in memory. \class PngRowWriter
+    class PngRowWriter
+    {
+    public:
+        /**
+         * @brief Constructor for PngRowWriter, nothing is opened yet.
+         */
+        PngRowWriter();
+
+        /**
+         * @brief Destructor, closes an open file.
+         */
+        ~PngRowWriter();
+
+        PngRowWriter(const PngRowWriter &) = delete;
+        PngRowWriter &operator=(const PngRowWriter &) = delete;
+
+        /**
+         * @brief Create the file and write the header.
+         * @param fileName The file name.
+         * @param width Image width in pixels.
+         * @param height Image height in pixels, exactly this many rows must follow.
+         * @return True on success.
+         */
+        bool open(const std::string &fileName, int width, int height);
+
+        /**
+         * @brief Compress and write the next row.
+         * @param rgb width * 3 bytes.
+         * @return True on success.
+         */
+        bool writeRow(const unsigned char *rgb);
+
+        /**
+         * @brief Write the end of the image and close the file.
+         * @return True on success.
+         */
+        bool close();
+
+    private:
+        void release();
+
+        std::FILE *m_file;
+        png_structp m_png;
+        png_infop m_info;
+    };
+}
+
+#endif // PNGROWWRITER_H
@@ -0,0 +1,191 @@
+#include "QuadtreeSampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Calculators;
+
+QuadtreeSampler::QuadtreeSampler(const int size, const int coarseStep, const double tolerance, const double ceiling)
+	: m_size(size)
+	, m_nodes(0)
+	, m_coarseStep(std::max(1, coarseStep))
+	, m_step(0)
+	, m_tolerance(tolerance)
+	, m_ceiling(ceiling)
+	, m_evaluations(0)
+{
+	// the coarse grid covers the map, the last cells may reach beyond its edge
+	const int cells = (std::max(size, 2) - 1 + m_coarseStep - 1) / m_coarseStep;
+	m_nodes = cells * m_coarseStep + 1;
+
+	m_values.resize(static_cast< std::size_t >(m_nodes) * m_nodes, 0.0f);
+	m_known.resize(m_values.size(), 0);
+}
+
+void QuadtreeSampler::refineTo(const int step, const Evaluator &evaluate)
+{
+	if(0 == m_step)
+	{
+		m_step = m_coarseStep;
+
+		for(int y = 0; y < m_nodes; y += m_step)
+		{
+			for(int x = 0; x < m_nodes; x += m_step)
+			{
+				sample(x, y, evaluate);
+			}
+		}
+
+		for(int y = 0; y + m_step < m_nodes; y += m_step)
+		{
+			for(int x = 0; x + m_step < m_nodes; x += m_step)
+			{
+				m_cells.push_back(Cell{ x, y });
+			}
+		}
+
+		for(const Cell &cell : m_cells)
+		{
+			interpolate(cell, m_step);
+		}
+	}
+
+	while(m_step > std::max(step, 1))
+	{
+		const int half = m_step / 2;
+		std::vector< Cell > next;
+
+		for(const Cell &cell : m_cells)
+		{
+			if(isSmooth(cell, m_step, evaluate))
+			{
+				interpolate(cell, m_step);
+				continue;
+			}
+
+			next.push_back(Cell{ cell.x, cell.y });
+			next.push_back(Cell{ cell.x + half, cell.y });
+			next.push_back(Cell{ cell.x, cell.y + half });
+			next.push_back(Cell{ cell.x + half, cell.y + half });
+		}
+
+		m_step = half;
+		m_cells.swap(next);
+
+		// cells of one node have no interior, every node of theirs is evaluated
+		if(1 == m_step)
+		{
+			m_cells.clear();
+		}
+
+		for(const Cell &cell : m_cells)
+		{
+			interpolate(cell, m_step);
+		}
+	}
+}
+
+void QuadtreeSampler::copyRows(const int firstRow, const int rowCount, const int stride, const int columns, float *rows) const
+{
+	const int last = m_nodes - 1;
+
+	for(int r = 0; r < rowCount; r++)
+	{
+		const int y = std::min((firstRow + r) * stride, last);
+
+		for(int x = 0; x < columns; x++)
+		{
+			rows[static_cast< std::size_t >(r) * columns + x] = static_cast< float >(value(std::min(x * stride, last), y));
+		}
+	}
+}
+
+int QuadtreeSampler::getStep() const
+{
+	return m_step;
+}
+
+std::size_t QuadtreeSampler::getEvaluations() const
+{
+	return m_evaluations;
+}
+
+double QuadtreeSampler::value(const int x, const int y) const
+{
+	return m_values[static_cast< std::size_t >(y) * m_nodes + x];
+}
+
+double QuadtreeSampler::visible(const int x, const int y) const
+{
+	return std::min(value(x, y), m_ceiling);
+}
+
+void QuadtreeSampler::sample(const int x, const int y, const Evaluator &evaluate)
+{
+	const std::size_t i = static_cast< std::size_t >(y) * m_nodes + x;
+
+	if(!m_known[i])
+	{
+		m_values[i] = static_cast< float >(evaluate(x, y));
+		m_known[i] = 1;
+		m_evaluations++;
+	}
+}
+
+bool QuadtreeSampler::isSmooth(const Cell &cell, const int step, const Evaluator &evaluate)
+{
+	const int half = step / 2;
+	const int x0 = cell.x;
+	const int y0 = cell.y;
+	const int x1 = x0 + step;
+	const int y1 = y0 + step;
+
+	// the centre and the edge midpoints are the corners of the children, they are not wasted if the cell is split
+	const int probes[5][2] = { { x0 + half, y0 + half }, { x0 + half, y0 }, { x0 + half, y1 }, { x0, y0 + half }, { x1, y0 + half } };
+
+	for(const auto &probe : probes)
+	{
+		sample(probe[0], probe[1], evaluate);
+	}
+
+	const double c00 = visible(x0, y0);
+	const double c10 = visible(x1, y0);
+	const double c01 = visible(x0, y1);
+	const double c11 = visible(x1, y1);
+
+	const double predicted[5] = { 0.25 * (c00 + c10 + c01 + c11), 0.5 * (c00 + c10), 0.5 * (c01 + c11), 0.5 * (c00 + c01), 0.5 * (c10 + c11) };
+
+	for(int p = 0; p < 5; p++)
+	{
+		if(std::abs(visible(probes[p][0], probes[p][1]) - predicted[p]) > m_tolerance)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void QuadtreeSampler::interpolate(const Cell &cell, const int step)
+{
+	const double c00 = visible(cell.x, cell.y);
+	const double c10 = visible(cell.x + step, cell.y);
+	const double c01 = visible(cell.x, cell.y + step);
+	const double c11 = visible(cell.x + step, cell.y + step);
+	const double inv = 1.0 / step;
+
+	for(int j = 0; j <= step; j++)
+	{
+		const double v = j * inv;
+		const std::size_t row = static_cast< std::size_t >(cell.y + j) * m_nodes + cell.x;
+
+		for(int i = 0; i <= step; i++)
+		{
+			if(!m_known[row + i])
+			{
+				const double u = i * inv;
+				m_values[row + i] = static_cast< float >((1.0 - v) * ((1.0 - u) * c00 + u * c10) + v * ((1.0 - u) * c01 + u * c11));
+			}
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#if !defined(QUADTREESAMPLER_H)
+#define QUADTREESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// @brief Potential Calculation Utilities. \namespace Calculators
+namespace Calculators
+{
+    /// @brief Coarse-to-fine sampling of a square grid: cells are split where bilinear interpolation misses, smooth cells are interpolated. \class QuadtreeSampler
+    class QuadtreeSampler
+    {
+    public:
+        /**
+         * @brief Evaluates the sampled function at a grid node.
+         * @param x Node column.
+         * @param y Node row.
+         * @return The value.
+         */
+        typedef std::function< double(int x, int y) > Evaluator;
+
+        /**
+         * @brief Constructor for QuadtreeSampler, nothing is evaluated yet.
+         * @param size Nodes per edge of the sampled grid.
+         * @param coarseStep Cell size of the first pass in nodes, a power of two.
+         * @param tolerance A cell is smooth when its centre and edge midpoints are this close to the interpolation.
+         * @param ceiling Values are compared clamped to this, e.g. where the palette saturates.
+         */
+        QuadtreeSampler(int size, int coarseStep, double tolerance, double ceiling);
+
+        /**
+         * @brief Run passes until no cell is larger than step. Every pass halves the cells that are not smooth;
+         * the nodes not evaluated so far are interpolated from the corners of their cell.
+         * @param step The cell size to reach, 1 for the exact map.
+         * @param evaluate The function, called only for nodes not evaluated before.
+         */
+        void refineTo(int step, const Evaluator &evaluate);
+
+        /**
+         * @brief Copy rows of the current approximation, every stride-th node in both directions.
+         * @param firstRow First output row, node row firstRow * stride.
+         * @param rowCount Number of rows.
+         * @param stride Node step, e.g. the cell size of a pass for a preview at the resolution it has resolved.
+         * @param columns Values per output row, nodes beyond the grid repeat its edge.
+         * @param rows Output, rowCount * columns values, rows[r * columns + x] is the node (x, firstRow + r) * stride.
+         */
+        void copyRows(int firstRow, int rowCount, int stride, int columns, float *rows) const;
+
+        /**
+         * @brief Getter for the size of the cells still to be refined.
+         * @return The cell size in nodes, 0 before the first pass.
+         */
+        int getStep() const;
+
+        /**
+         * @brief Getter for the number of nodes evaluated so far, including those beyond the edge the coarse grid needs.
+         * @return The evaluation count.
+         */
+        std::size_t getEvaluations() const;
+
+    private:
+        /// @brief A cell by its lower corner. \struct Cell
+        struct Cell
+        {
+            int x;
+            int y;
+        };
+
+        double value(int x, int y) const;
+        double visible(int x, int y) const;
+        void sample(int x, int y, const Evaluator &evaluate);
+        bool isSmooth(const Cell &cell, int step, const Evaluator &evaluate);
+        void interpolate(const Cell &cell, int step);
+
+        int m_size;
+        int m_nodes;
+        int m_coarseStep;
+        int m_step;
+        double m_tolerance;
+        double m_ceiling;
+        std::vector< float > m_values;
+        std::vector< uint8_t > m_known;
+        std::vector< Cell > m_cells;
+        std::size_t m_evaluations;
+    };
+}
+
+#endif // QUADTREESAMPLER_H
@@ -0,0 +1,424 @@
+#include "SlicePipeline.h"
+#include "BoundedQueue.h"
+#include "PngRowWriter.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/gil/extension/io/png.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace gil = boost::gil;
+
+using namespace Pipeline;
+
+namespace
+{
+	/// @brief A rendered slice on its way to the encoders. \struct SliceJob
+	struct SliceJob
+	{
+		int top;
+		int bottom;
+		gil::rgb8_image_t img;
+		gil::rgb8_image_t grid;
+	};
+
+	/// @brief Quadrant rows mirrored into full slice rows and rendered through a palette. \struct SliceRenderer
+	struct SliceRenderer
+	{
+		const Colourisers::Palette &palette;
+		const float *rows;
+		int firstRow;
+		int rowLength;
+		int xy_slices;
+		double invLimit;
+		int contourLevels;
+
+		/**
+		 * @brief Normalised value of a pixel, the quadrant holds pixel offsets from the centre.
+		 * @param x Pixel column.
+		 * @param y Pixel row, its quadrant row must be among the filled rows.
+		 * @return potential / limit, 0 for the edge row and column an even slice has beyond the quadrant.
+		 */
+		double normalised(const int x, const int y) const
+		{
+			const int xy_half = xy_slices / 2;
+			const int qx = std::abs(x - xy_half);
+			const int qy = std::abs(y - xy_half);
+
+			if(qx >= rowLength || qy >= rowLength)
+			{
+				return 0.0;
+			}
+
+			return rows[(qy - firstRow) * rowLength + qx] * invLimit;
+		}
+
+		/**
+		 * @brief Contour band of every pixel of a row.
+		 * @param y Pixel row.
+		 * @param bands Output, one band per pixel.
+		 */
+		void bandRow(const int y, std::vector< int > &bands) const
+		{
+			const double perBand = contourLevels / palette.getSpan();
+
+			for(int x = 0; x < xy_slices; x++)
+			{
+				bands[x] = static_cast< int >(std::min(std::max(normalised(x, y) * perBand, 0.0), static_cast< double >(contourLevels)));
+			}
+		}
+
+		/**
+		 * @brief Write one row of the plain and the gridded image, with contour lines in the gridded one.
+		 * Rows y and y + 1 must be filled when contours are drawn.
+		 * @param y Pixel row.
+		 * @param bands In/out, the bands of row y on entry (see bandRow), those of row y + 1 on return.
+		 * @param nextBands Scratch row of bands.
+		 * @param plainRow The row of the plain image.
+		 * @param gridRow The row of the image with the grid and the contours.
+		 */
+		void renderRow(const int y, std::vector< int > &bands, std::vector< int > &nextBands,
+					   const gil::rgb8_view_t::x_iterator &plainRow, const gil::rgb8_view_t::x_iterator &gridRow) const
+		{
+			const gil::rgb8_pixel_t black(0, 0, 0);
+			const gil::rgb8_pixel_t white(255, 255, 255);
+			const bool gridLine = 0 == y % 10;
+
+			if(contourLevels > 0 && y + 1 < xy_slices)
+			{
+				bandRow(y + 1, nextBands);
+			}
+
+			for(int x = 0; x < xy_slices; x++)
+			{
+				const Colourisers::PaletteEntry &colour = palette.lookup(normalised(x, y));
+				const gil::rgb8_pixel_t pixel(colour.red, colour.green, colour.blue);
+
+				plainRow[x] = pixel;
+
+				if(gridLine || 0 == x % 10)
+				{
+					gridRow[x] = black;
+				}
+				else if(contourLevels > 0 && ((x + 1 < xy_slices && bands[x] != bands[x + 1]) ||
+											  (y + 1 < xy_slices && bands[x] != nextBands[x])))
+				{
+					gridRow[x] = white;
+				}
+				else
+				{
+					gridRow[x] = pixel;
+				}
+			}
+
+			bands.swap(nextBands);
+		}
+	};
+
+	/**
+	 * @brief Copy a finished file, the lower slices are mirror images of the upper ones.
+	 * @param from Source file name.
+	 * @param to Target file name.
+	 * @return True on success.
+	 */
+	bool copyFile(const std::string &from, const std::string &to)
+	{
+		std::ifstream in(from, std::ios::binary);
+		std::ofstream out(to, std::ios::binary);
+
+		if(!in || !out)
+		{
+			return false;
+		}
+
+		out << in.rdbuf();
+		return static_cast< bool >(out);
+	}
+
+	/**
+	 * @brief File name of a slice image.
+	 * @param prefix File name prefix.
+	 * @param kind slice or grid.
+	 * @param index Slice number.
+	 * @return The name.
+	 */
+	std::string sliceFileName(const std::string &prefix, const std::string &kind, const int index)
+	{
+		return prefix + kind + boost::lexical_cast<std::string>(index) + ".png";
+	}
+}
+
+SlicePipeline::SlicePipeline(const int z_slices, const int xy_slices, const int rowLength)
+	: m_zSlices(z_slices)
+	, m_xySlices(xy_slices)
+	, m_rowLength(rowLength)
+	, m_workers(std::max(1u, std::thread::hardware_concurrency()))
+	, m_encoders(std::max(1u, std::thread::hardware_concurrency() / 2))
+	, m_contourLevels(0)
+	, m_stripHeight(0)
+{
+}
+
+void SlicePipeline::setPalette(const Colourisers::Palette &palette)
+{
+	m_palette = palette;
+}
+
+void SlicePipeline::setContourLevels(const int levels)
+{
+	m_contourLevels = std::max(0, levels);
+}
+
+void SlicePipeline::setStripHeight(const int rows)
+{
+	m_stripHeight = std::max(0, rows);
+}
+
+int SlicePipeline::getSliceCount() const
+{
+	return m_zSlices - m_zSlices / 2;
+}
+
+void SlicePipeline::run(const std::string &prefix, const SliceFiller &fill, const double limit, double &minValue, double &maxValue) const
+{
+	if(m_stripHeight > 0)
+	{
+		runStreaming(prefix, fill, limit, minValue, maxValue);
+	}
+	else
+	{
+		runWhole(prefix, fill, limit, minValue, maxValue);
+	}
+}
+
+void SlicePipeline::runWhole(const std::string &prefix, const SliceFiller &fill, const double limit, double &minValue, double &maxValue) const
+{
+	const int first_z = m_zSlices / 2;
+	const int slice_count = getSliceCount();
+
+	// finished slices wait here for the encoders, the bound caps the number of images held in memory
+	BoundedQueue< std::unique_ptr< SliceJob > > queue(2 * m_encoders);
+
+	std::vector< double > minPerWorker(m_workers, std::numeric_limits< double >::max());
+	std::vector< double > maxPerWorker(m_workers, std::numeric_limits< double >::min());
+	std::atomic< int > nextSlice(0);
+	std::mutex coutMutex;
+
+	auto computeSlices = [&](const unsigned worker)
+	{
+		double localMin = std::numeric_limits< double >::max();
+		double localMax = std::numeric_limits< double >::min();
+		std::vector< float > quadrant(static_cast< std::size_t >(m_rowLength) * m_rowLength);
+		std::vector< int > bands(m_xySlices);
+		std::vector< int > nextBands(m_xySlices);
+		const SliceRenderer renderer{ m_palette, quadrant.data(), 0, m_rowLength, m_xySlices, 1.0 / limit, m_contourLevels };
+
+		for(int k = nextSlice++; k < slice_count; k = nextSlice++)
+		{
+			const int z = first_z + k;
+
+			{
+				std::lock_guard< std::mutex > lock(coutMutex);
+				std::cout << "Calculating slice " << k + 1 << " of " << m_zSlices / 2 << std::endl;
+			}
+
+			auto job = std::make_unique< SliceJob >();
+			job->top = m_zSlices - z;
+			job->bottom = z;
+			job->img = gil::rgb8_image_t(m_xySlices, m_xySlices);
+			job->grid = gil::rgb8_image_t(m_xySlices, m_xySlices);
+
+			fill(k, 0, m_rowLength, quadrant.data(), localMin, localMax);
+
+			const gil::rgb8_view_t plain = gil::view(job->img);
+			const gil::rgb8_view_t grid = gil::view(job->grid);
+
+			if(m_contourLevels > 0)
+			{
+				renderer.bandRow(0, bands);
+			}
+
+			for(int y = 0; y < m_xySlices; y++)
+			{
+				renderer.renderRow(y, bands, nextBands, plain.row_begin(y), grid.row_begin(y));
+			}
+
+			queue.push(std::move(job));
+		}
+
+		minPerWorker[worker] = localMin;
+		maxPerWorker[worker] = localMax;
+	};
+
+	auto encodeSlices = [&]()
+	{
+		std::unique_ptr< SliceJob > job;
+
+		while(queue.pop(job))
+		{
+			try
+			{
+				const std::string plainName = sliceFileName(prefix, "slice", job->top);
+
+				gil::write_view(plainName, gil::view(job->img), gil::png_tag());
+				gil::write_view(sliceFileName(prefix, "grid", job->top), gil::view(job->grid), gil::png_tag());
+
+				if(job->top != job->bottom && !copyFile(plainName, sliceFileName(prefix, "slice", job->bottom)))
+				{
+					std::lock_guard< std::mutex > lock(coutMutex);
+					std::cout << "Unable to write images for slice " << job->bottom << std::endl;
+				}
+			}
+			catch(const std::exception& ex)
+			{
+				std::lock_guard< std::mutex > lock(coutMutex);
+				std::cout << "Unable to write images for slice " << job->top << std::endl;
+				std::cout << ex.what() << std::endl;
+			}
+		}
+	};
+
+	std::vector< std::thread > encoderThreads;
+	for(unsigned e = 0; e < m_encoders; e++)
+	{
+		encoderThreads.emplace_back(encodeSlices);
+	}
+
+	std::vector< std::thread > workerThreads;
+	for(unsigned w = 0; w < m_workers; w++)
+	{
+		workerThreads.emplace_back(computeSlices, w);
+	}
+
+	for(auto &t : workerThreads)
+	{
+		t.join();
+	}
+
+	queue.close();
+
+	for(auto &t : encoderThreads)
+	{
+		t.join();
+	}
+
+	minValue = *std::min_element(minPerWorker.begin(), minPerWorker.end());
+	maxValue = *std::max_element(maxPerWorker.begin(), maxPerWorker.end());
+}
+
+void SlicePipeline::runStreaming(const std::string &prefix, const SliceFiller &fill, const double limit, double &minValue, double &maxValue) const
+{
+	const int first_z = m_zSlices / 2;
+	const int slice_count = getSliceCount();
+	const int xy_half = m_xySlices / 2;
+	const bool contours = m_contourLevels > 0;
+
+	std::vector< double > minPerWorker(m_workers, std::numeric_limits< double >::max());
+	std::vector< double > maxPerWorker(m_workers, std::numeric_limits< double >::min());
+	std::atomic< int > nextSlice(0);
+	std::mutex coutMutex;
+
+	// every worker compresses its own slices, nothing larger than a strip is ever held
+	auto streamSlices = [&](const unsigned worker)
+	{
+		double localMin = std::numeric_limits< double >::max();
+		double localMax = std::numeric_limits< double >::min();
+
+		// a strip straddling the centre row needs at most stripHeight + 1 quadrant rows, plus one for the contour lookahead
+		std::vector< float > strip(static_cast< std::size_t >(m_stripHeight + 2) * m_rowLength);
+		std::vector< int > bands(m_xySlices);
+		std::vector< int > nextBands(m_xySlices);
+		gil::rgb8_image_t plainRow(m_xySlices, 1);
+		gil::rgb8_image_t gridRow(m_xySlices, 1);
+		const gil::rgb8_view_t plain = gil::view(plainRow);
+		const gil::rgb8_view_t grid = gil::view(gridRow);
+		SliceRenderer renderer{ m_palette, strip.data(), 0, m_rowLength, m_xySlices, 1.0 / limit, m_contourLevels };
+		PngRowWriter plainWriter;
+		PngRowWriter gridWriter;
+
+		for(int k = nextSlice++; k < slice_count; k = nextSlice++)
+		{
+			const int z = first_z + k;
+			const int top = m_zSlices - z;
+			const std::string plainName = sliceFileName(prefix, "slice", top);
+
+			{
+				std::lock_guard< std::mutex > lock(coutMutex);
+				std::cout << "Calculating slice " << k + 1 << " of " << m_zSlices / 2 << std::endl;
+			}
+
+			bool written = plainWriter.open(plainName, m_xySlices, m_xySlices) &&
+						   gridWriter.open(sliceFileName(prefix, "grid", top), m_xySlices, m_xySlices);
+
+			for(int y0 = 0; written && y0 < m_xySlices; y0 += m_stripHeight)
+			{
+				const int y1 = std::min(y0 + m_stripHeight, m_xySlices);
+				const int lastRow = contours && y1 < m_xySlices ? y1 : y1 - 1;
+
+				// image rows mirror around the centre, the strip covers a contiguous range of quadrant rows
+				const int q0 = std::abs(y0 - xy_half);
+				const int q1 = std::abs(lastRow - xy_half);
+				const int firstRow = y0 <= xy_half && xy_half <= lastRow ? 0 : std::min(q0, q1);
+				const int endRow = std::min(std::max(q0, q1) + 1, m_rowLength);
+
+				if(firstRow < endRow)
+				{
+					fill(k, firstRow, endRow - firstRow, strip.data(), localMin, localMax);
+				}
+
+				renderer.firstRow = firstRow;
+
+				if(contours && 0 == y0)
+				{
+					renderer.bandRow(0, bands);
+				}
+
+				for(int y = y0; written && y < y1; y++)
+				{
+					renderer.renderRow(y, bands, nextBands, plain.row_begin(0), grid.row_begin(0));
+
+					written = plainWriter.writeRow(gil::interleaved_view_get_raw_data(plain)) &&
+							  gridWriter.writeRow(gil::interleaved_view_get_raw_data(grid));
+				}
+			}
+
+			written = written && plainWriter.close() && gridWriter.close();
+
+			if(written && top != z)
+			{
+				written = copyFile(plainName, sliceFileName(prefix, "slice", z));
+			}
+
+			if(!written)
+			{
+				std::lock_guard< std::mutex > lock(coutMutex);
+				std::cout << "Unable to write images for slice " << top << std::endl;
+			}
+		}
+
+		minPerWorker[worker] = localMin;
+		maxPerWorker[worker] = localMax;
+	};
+
+	std::vector< std::thread > workerThreads;
+	for(unsigned w = 0; w < m_workers; w++)
+	{
+		workerThreads.emplace_back(streamSlices, w);
+	}
+
+	for(auto &t : workerThreads)
+	{
+		t.join();
+	}
+
+	minValue = *std::min_element(minPerWorker.begin(), minPerWorker.end());
+	maxValue = *std::max_element(maxPerWorker.begin(), maxPerWorker.end());
+}
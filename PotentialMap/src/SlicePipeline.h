@@ -0,0 +1,92 @@
+#if !defined(SLICEPIPELINE_H)
+#define SLICEPIPELINE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <boost/gil/typedefs.hpp>
+#include <boost/gil/image.hpp>
+
+#include "Colourisers.h"
+
+/// @brief Slice rendering pipeline: work queue, slice driver and PNG output. \namespace Pipeline
+namespace Pipeline
+{
+    /// @brief Computes z-slices on a worker pool and hands the images to an encoder pool through a bounded queue. \class SlicePipeline
+    class SlicePipeline
+    {
+    public:
+        /**
+         * @brief Computes the potential of rows of one slice quadrant, the renderer mirrors them into the four quadrants.
+         * @param sliceIndex Index of the slice from the centre plane, 0 to sliceCount - 1.
+         * @param firstRow First quadrant row (y offset from the centre) to compute.
+         * @param rowCount Number of rows.
+         * @param rows Output, rowCount * rowLength potentials, rows[r * rowLength + x] is the point (x, firstRow + r).
+         * @param minValue In/out, running minimum of the worker.
+         * @param maxValue In/out, running maximum of the worker.
+         */
+        typedef std::function< void(int sliceIndex, int firstRow, int rowCount, float *rows, double &minValue, double &maxValue) > SliceFiller;
+
+        /**
+         * @brief Constructor for SlicePipeline.
+         * @param z_slices Number of z-slices of the full map, the upper half is computed and mirrored.
+         * @param xy_slices Edge length of a slice in pixels.
+         * @param rowLength Edge length of the computed quadrant.
+         */
+        SlicePipeline(int z_slices, int xy_slices, int rowLength);
+
+        /**
+         * @brief Compute and write all slices, named <prefix>slice<n>.png and <prefix>grid<n>.png.
+         * Each quadrant is rendered in one pass through the palette into the plain and the gridded image.
+         * With a strip height set, every worker streams its slices strip by strip straight into the PNG files.
+         * @param prefix File name prefix.
+         * @param fill The slice filler, called concurrently from the workers.
+         * @param limit The potential is coloured as potential / limit, as ColouriserCreator::colourise() reads it.
+         * @param minValue Output, minimum over all workers.
+         * @param maxValue Output, maximum over all workers.
+         */
+        void run(const std::string &prefix, const SliceFiller &fill, double limit, double &minValue, double &maxValue) const;
+
+        /**
+         * @brief Setter for the colour map.
+         * @param palette The palette.
+         */
+        void setPalette(const Colourisers::Palette &palette);
+
+        /**
+         * @brief Setter for the contour lines drawn into the gridded image.
+         * @param levels Number of equal steps over the span of the palette, 0 for none.
+         */
+        void setContourLevels(int levels);
+
+        /**
+         * @brief Setter for streaming output: slices are computed, rendered and compressed in strips of this many
+         * image rows, so memory no longer grows with the slice size. The quadrant rows are computed twice, once
+         * for each mirrored half.
+         * @param rows Strip height in image rows, 0 to keep whole slices in memory.
+         */
+        void setStripHeight(int rows);
+
+        /**
+         * @brief Getter for the number of computed slices.
+         * @return The number of slices from the centre plane up.
+         */
+        int getSliceCount() const;
+
+    private:
+        void runWhole(const std::string &prefix, const SliceFiller &fill, double limit, double &minValue, double &maxValue) const;
+        void runStreaming(const std::string &prefix, const SliceFiller &fill, double limit, double &minValue, double &maxValue) const;
+
+        int m_zSlices;
+        int m_xySlices;
+        int m_rowLength;
+        unsigned m_workers;
+        unsigned m_encoders;
+        Colourisers::Palette m_palette;
+        int m_contourLevels;
+        int m_stripHeight;
+    };
+}
+
+#endif // SLICEPIPELINE_H
@@ -9,21 +9,625 @@
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <cmath>
+#include <sstream>
 #include <vector>
 
 #include "Colourisers.h"
 #include "Calculators.h"
+#include "DistanceField.h"
 #include "GeneralEE.h"
+#include "LaplaceSolver.h"
+#include "QuadtreeSampler.h"
+#include "SlicePipeline.h"
 
 namespace gil = boost::gil;
 
 using namespace Calculators;
 using namespace Colourisers;
 using namespace GeneralEE;
+using namespace Pipeline;
+
+/// @brief Colour map and overlays of the rendered slices. \struct RenderOptions
+struct RenderOptions
+{
+	Palette::Map map;
+	int contourLevels;
+	int stripHeight;
+};
+
+/**
+ * @brief Take --palette <hls|grey|viridis>, --contours <n> and --strip <rows> out of the arguments, wherever they stand.
+ * @param argc In/out, argument count without the options.
+ * @param argv In/out, arguments without the options.
+ * @param options Output, the render options.
+ * @return False for an unknown palette or a bad count.
+ */
+static bool extractRenderOptions(int &argc, const char** argv, RenderOptions &options)
+{
+	int kept = 1;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const std::string arg(argv[i]);
+
+		if(arg == "--palette" && i + 1 < argc)
+		{
+			if(!Palette::fromName(argv[++i], options.map))
+			{
+				std::cout << "Unknown palette " << argv[i] << ", use hls, grey or viridis.\n";
+				return false;
+			}
+		}
+		else if(arg == "--contours" && i + 1 < argc)
+		{
+			try
+			{
+				options.contourLevels = boost::lexical_cast<int>(argv[++i]);
+			}
+			catch(const boost::bad_lexical_cast& ex)
+			{
+				std::cout << "Unable to understand the number of contour levels.\n" << ex.what();
+				return false;
+			}
+		}
+		else if(arg == "--strip" && i + 1 < argc)
+		{
+			try
+			{
+				options.stripHeight = boost::lexical_cast<int>(argv[++i]);
+			}
+			catch(const boost::bad_lexical_cast& ex)
+			{
+				std::cout << "Unable to understand the strip height.\n" << ex.what();
+				return false;
+			}
+		}
+		else
+		{
+			argv[kept++] = argv[i];
+		}
+	}
+
+	argc = kept;
+	return true;
+}
+
+/**
+ * @brief Slice pipeline for a geometry, with the palette and overlays of the options.
+ * @param geometry The geometry and sampling.
+ * @param options The render options.
+ * @return The pipeline.
+ */
+static SlicePipeline makePipeline(const MapGeometry &geometry, const RenderOptions &options)
+{
+	SlicePipeline pipeline(geometry.z_slices, geometry.xy_slices, geometry.rowLength());
+	pipeline.setPalette(Palette(options.map));
+	pipeline.setContourLevels(options.contourLevels);
+	pipeline.setStripHeight(options.stripHeight);
+	return pipeline;
+}
+
+/**
+ * @brief Voltage sweep: the distance field is computed once per geometry (or loaded), every voltage is one scale-and-colourise pass.
+ * @param argc Argument count.
+ * @param argv sweep <z slices> <xy slices> <axis mm> <radius mm> <kV list, comma separated> [rings].
+ * @param options The render options.
+ * @return Exit code.
+ */
+static int runSweep(const int argc, const char** argv, const RenderOptions &options)
+{
+	if(argc != 7 && argc != 8)
+	{
+		std::cout << "Params\n"
+				  << "\tsweep\n"
+				  << "\t<number of z-axis slices>\n"
+				  << "\t<number of xy slices (pixel size)>\n"
+				  << "\t<axis size in mm>\n"
+				  << "\t<radius of poissor in mm>\n"
+				  << "\t<input voltages (kV), comma separated>\n"
+				  << "\t[number of cathode rings, default 3]\n"
+				  << "\n\nExample: ./PotentialMap sweep 10 256 5 1 10,20,30\n";
+		return 0;
+	}
+
+	MapGeometry geometry{ 0, 0, 0, 0, 3 };
+	std::vector< int > voltages;
+
+	try
+	{
+		geometry.z_slices = boost::lexical_cast<int>(argv[2]);
+		geometry.xy_slices = boost::lexical_cast<int>(argv[3]);
+		geometry.axis_max = boost::lexical_cast<int>(argv[4]);
+		geometry.radius = boost::lexical_cast<int>(argv[5]);
+
+		std::istringstream list(argv[6]);
+		std::string item;
+		while(std::getline(list, item, ','))
+		{
+			voltages.push_back(boost::lexical_cast<int>(item) * 1000);
+		}
+
+		if(argc == 8)
+		{
+			geometry.ringCount = boost::lexical_cast<int>(argv[7]);
+		}
+	}
+	catch(const boost::bad_lexical_cast& ex)
+	{
+		std::cout << "Unable to understand parameters. Use integer values only!\n" << ex.what();
+		return 0;
+	}
+
+	if(geometry.ringCount < 1 || voltages.empty())
+	{
+		std::cout << "Need at least one cathode ring and one voltage.\n";
+		return 0;
+	}
+
+	DistanceField field(geometry);
+	const std::string fieldName = field.defaultFileName();
+
+	if(field.load(fieldName))
+	{
+		std::cout << "Loaded distance field " << fieldName << std::endl;
+	}
+	else
+	{
+		std::cout << "Computing distance field ..." << std::endl;
+		field.compute();
+
+		if(field.save(fieldName))
+		{
+			std::cout << "Saved distance field " << fieldName << std::endl;
+		}
+		else
+		{
+			std::cout << "Unable to save distance field " << fieldName << std::endl;
+		}
+	}
+
+	const int row_length = geometry.rowLength();
+	const SlicePipeline pipeline = makePipeline(geometry, options);
+
+	for(const int kV : voltages)
+	{
+		std::cout << "Rendering " << kV / 1000 << " kV" << std::endl;
+
+		double minPotential = 0.0;
+		double maxPotential = 0.0;
+
+		pipeline.run("kV" + boost::lexical_cast<std::string>(kV / 1000) + "_",
+			[&](const int k, const int firstRow, const int rowCount, float *rows, double &localMin, double &localMax)
+			{
+				const float *dist = field.slice(k);
+
+				for(int x = 0; x < row_length; x++)
+				{
+					const float *column = dist + static_cast< std::size_t >(x) * row_length + firstRow;
+
+					for(int r = 0; r < rowCount; r++)
+					{
+						const double potential = kV / column[r];
+						localMin = std::min(localMin, potential);
+						localMax = std::max(localMax, potential);
+
+						rows[r * row_length + x] = static_cast< float >(potential);
+					}
+				}
+			},
+			kV,
+			minPotential, maxPotential);
+
+		std::cout << "Min = " << minPotential << "\n";
+		std::cout << "Max = " << maxPotential << "\n";
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Solve Laplace's equation between the cathode rings and a spherical anode at the edge of the map, render the usual slices.
+ * @param argc Argument count.
+ * @param argv laplace <z slices> <xy slices> <axis mm> <radius mm> <kV> [rings] [grid cells].
+ * @param options The render options.
+ * @return Exit code.
+ */
+static int runLaplace(const int argc, const char** argv, const RenderOptions &options)
+{
+	if(argc < 7 || argc > 9)
+	{
+		std::cout << "Params\n"
+				  << "\tlaplace\n"
+				  << "\t<number of z-axis slices>\n"
+				  << "\t<number of xy slices (pixel size)>\n"
+				  << "\t<axis size in mm>\n"
+				  << "\t<radius of poissor in mm>\n"
+				  << "\t<input voltage (kV)>\n"
+				  << "\t[number of cathode rings, default 3]\n"
+				  << "\t[grid cells per edge, power of two, default 128]\n"
+				  << "\n\nExample: ./PotentialMap laplace 10 256 5 1 30 3 256\n";
+		return 0;
+	}
+
+	MapGeometry geometry{ 0, 0, 0, 0, 3 };
+	int kV = 0;
+	int cells = 128;
+
+	try
+	{
+		geometry.z_slices = boost::lexical_cast<int>(argv[2]);
+		geometry.xy_slices = boost::lexical_cast<int>(argv[3]);
+		geometry.axis_max = boost::lexical_cast<int>(argv[4]);
+		geometry.radius = boost::lexical_cast<int>(argv[5]);
+		kV = boost::lexical_cast<int>(argv[6]) * 1000;
+
+		if(argc >= 8)
+		{
+			geometry.ringCount = boost::lexical_cast<int>(argv[7]);
+		}
+
+		if(argc == 9)
+		{
+			cells = boost::lexical_cast<int>(argv[8]);
+		}
+	}
+	catch(const boost::bad_lexical_cast& ex)
+	{
+		std::cout << "Unable to understand parameters. Use integer values only!\n" << ex.what();
+		return 0;
+	}
+
+	if(geometry.ringCount < 1 || cells < 8 || (cells & (cells - 1)) != 0)
+	{
+		std::cout << "Need at least one cathode ring and a power of two of at least 8 grid cells.\n";
+		return 0;
+	}
+
+	if(geometry.radius >= geometry.axis_max)
+	{
+		std::cout << "The cathode must lie inside the anode, radius < axis size.\n";
+		return 0;
+	}
+
+	// the map spans +-axis_max, the anode is the sphere inscribed in it
+	const double halfExtent = geometry.axis_max / 1000.0;
+
+	LaplaceSolver solver(cells, halfExtent);
+	solver.setBoundaries(PotentialCalulator::spiralRings(geometry.radius, geometry.ringCount), kV, halfExtent);
+
+	std::cout << "Solving on " << solver.getNodes() << "^3 nodes, " << solver.getLevelCount() << " grid levels ..." << std::endl;
+
+	const int cycles = solver.solve(1e-5, 100);
+
+	std::cout << "V-cycles = " << cycles << ", residual = " << solver.getResidual() << std::endl;
+
+	std::ostringstream volumeName;
+	volumeName << "laplace_g" << cells << "_a" << geometry.axis_max << "_r" << geometry.radius
+			   << "_n" << geometry.ringCount << "_kV" << kV / 1000 << ".vtk";
+
+	if(solver.save(volumeName.str(), kV))
+	{
+		std::cout << "Saved potential volume " << volumeName.str() << std::endl;
+	}
+	else
+	{
+		std::cout << "Unable to save potential volume " << volumeName.str() << std::endl;
+	}
+
+	const int row_length = geometry.rowLength();
+	const SlicePipeline pipeline = makePipeline(geometry, options);
+
+	// the colouriser reads potential / limit as a hue in degrees, the solved potential stays within [0, kV]
+	const double hueLimit = kV / 360.0;
+
+	double minPotential = 0.0;
+	double maxPotential = 0.0;
+
+	pipeline.run("laplace_",
+		[&](const int k, const int firstRow, const int rowCount, float *rows, double &localMin, double &localMax)
+		{
+			const double z_pos = geometry.zPos(k);
+
+			for(int r = 0; r < rowCount; r++)
+			{
+				for(int x = 0; x < row_length; x++)
+				{
+					const double potential = solver.sample(geometry.xyPos(x), geometry.xyPos(firstRow + r), z_pos);
+					localMin = std::min(localMin, potential);
+					localMax = std::max(localMax, potential);
+
+					rows[r * row_length + x] = static_cast< float >(potential);
+				}
+			}
+		},
+		hueLimit, minPotential, maxPotential);
+
+	std::cout << "Min = " << minPotential << "\n";
+	std::cout << "Max = " << maxPotential << "\n";
+
+	return 1;
+}
+
+/**
+ * @brief Progressive map: every slice starts on a coarse grid and is refined where interpolation misses, a preview is written after each pass.
+ * @param argc Argument count.
+ * @param argv progressive <z slices> <xy slices> <axis mm> <radius mm> <kV> [rings] [coarse step].
+ * @param options The render options.
+ * @return Exit code.
+ */
+static int runProgressive(const int argc, const char** argv, const RenderOptions &options)
+{
+	if(argc < 7 || argc > 9)
+	{
+		std::cout << "Params\n"
+				  << "\tprogressive\n"
+				  << "\t<number of z-axis slices>\n"
+				  << "\t<number of xy slices (pixel size)>\n"
+				  << "\t<axis size in mm>\n"
+				  << "\t<radius of poissor in mm>\n"
+				  << "\t<input voltage (kV)>\n"
+				  << "\t[number of cathode rings, default 3]\n"
+				  << "\t[cell size of the first pass in pixels, power of two, default 16]\n"
+				  << "\n\nExample: ./PotentialMap progressive 10 1024 5 1 30 3 16\n";
+		return 0;
+	}
+
+	MapGeometry geometry{ 0, 0, 0, 0, 3 };
+	int kV = 0;
+	int coarseStep = 16;
+
+	try
+	{
+		geometry.z_slices = boost::lexical_cast<int>(argv[2]);
+		geometry.xy_slices = boost::lexical_cast<int>(argv[3]);
+		geometry.axis_max = boost::lexical_cast<int>(argv[4]);
+		geometry.radius = boost::lexical_cast<int>(argv[5]);
+		kV = boost::lexical_cast<int>(argv[6]) * 1000;
+
+		if(argc >= 8)
+		{
+			geometry.ringCount = boost::lexical_cast<int>(argv[7]);
+		}
+
+		if(argc == 9)
+		{
+			coarseStep = boost::lexical_cast<int>(argv[8]);
+		}
+	}
+	catch(const boost::bad_lexical_cast& ex)
+	{
+		std::cout << "Unable to understand parameters. Use integer values only!\n" << ex.what();
+		return 0;
+	}
+
+	if(geometry.ringCount < 1 || coarseStep < 1 || (coarseStep & (coarseStep - 1)) != 0)
+	{
+		std::cout << "Need at least one cathode ring and a power of two as the first cell size.\n";
+		return 0;
+	}
+
+	const std::vector< RingWire > rings = PotentialCalulator::spiralRings(geometry.radius, geometry.ringCount);
+	const int row_length = geometry.rowLength();
+	// the upper half of the slices, see SlicePipeline::getSliceCount()
+	const int slice_count = geometry.z_slices - geometry.z_slices / 2;
+
+	// the colouriser reads potential / kV as a hue in degrees: refine until interpolation is off by less than
+	// a quarter degree, about one colour level, and treat everything beyond the end of the palette as equal
+	const double tolerance = 0.25 * kV;
+	const double ceiling = Palette(options.map).getSpan() * kV;
+
+	std::vector< QuadtreeSampler > samplers;
+	for(int k = 0; k < slice_count; k++)
+	{
+		samplers.emplace_back(row_length, coarseStep, tolerance, ceiling);
+	}
+
+	const double fullMap = static_cast< double >(slice_count) * row_length * row_length;
+
+	for(int step = coarseStep; step >= 1; step /= 2)
+	{
+		// a pass has resolved every step-th pixel, its preview is written at that resolution and costs little to encode
+		MapGeometry passGeometry = geometry;
+		passGeometry.xy_slices = std::max(geometry.xy_slices / step, 2);
+
+		const int pass_length = passGeometry.rowLength();
+		const SlicePipeline passPipeline = makePipeline(passGeometry, options);
+
+		double minPotential = 0.0;
+		double maxPotential = 0.0;
+
+		passPipeline.run(step > 1 ? "preview" + boost::lexical_cast<std::string>(step) + "_" : "",
+			[&](const int k, const int firstRow, const int rowCount, float *rows, double &localMin, double &localMax)
+			{
+				const double z_pos = geometry.zPos(k);
+
+				samplers[k].refineTo(step,
+					[&](const int x, const int y)
+					{
+						double potential = 0.0;
+						PotentialCalulator::calcPotentialRow(geometry.xyPos(x), geometry.xyPos(y), 0.0, z_pos, 1, rings, kV, &potential);
+						return potential;
+					});
+
+				samplers[k].copyRows(firstRow, rowCount, step, pass_length, rows);
+
+				for(std::size_t i = 0; i < static_cast< std::size_t >(rowCount) * pass_length; i++)
+				{
+					localMin = std::min(localMin, static_cast< double >(rows[i]));
+					localMax = std::max(localMax, static_cast< double >(rows[i]));
+				}
+			},
+			kV, minPotential, maxPotential);
+
+		std::size_t evaluations = 0;
+		for(const QuadtreeSampler &sampler : samplers)
+		{
+			evaluations += sampler.getEvaluations();
+		}
+
+		std::cout << "Cell size " << step << ": " << evaluations << " evaluations, "
+				  << 100.0 * evaluations / fullMap << "% of the full map" << std::endl;
+
+		if(1 == step)
+		{
+			std::cout << "Min = " << minPotential << "\n";
+			std::cout << "Max = " << maxPotential << "\n";
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Parse a sweep axis: a comma separated list, first:last:count for even steps or first:last:count:log for even ratios.
+ * @param text The axis.
+ * @param values Output, the values.
+ * @return False if the axis is empty or malformed.
+ */
+static bool parseAxis(const std::string &text, std::vector< double > &values)
+{
+	std::vector< std::string > parts;
+	std::istringstream fields(text);
+	std::string part;
+
+	while(std::getline(fields, part, ':'))
+	{
+		parts.push_back(part);
+	}
+
+	values.clear();
+
+	try
+	{
+		if(parts.size() == 3 || (parts.size() == 4 && parts[3] == "log"))
+		{
+			const double first = boost::lexical_cast<double>(parts[0]);
+			const double last = boost::lexical_cast<double>(parts[1]);
+			const int count = boost::lexical_cast<int>(parts[2]);
+			const bool logarithmic = parts.size() == 4;
+
+			if(count < 1 || (logarithmic && (first <= 0.0 || last <= 0.0)))
+			{
+				return false;
+			}
+
+			for(int i = 0; i < count; i++)
+			{
+				const double t = count > 1 ? static_cast< double >(i) / (count - 1) : 0.0;
+				values.push_back(logarithmic ? first * std::pow(last / first, t) : first + (last - first) * t);
+			}
+		}
+		else if(parts.size() == 1)
+		{
+			std::istringstream list(text);
+			std::string item;
+			while(std::getline(list, item, ','))
+			{
+				values.push_back(boost::lexical_cast<double>(item));
+			}
+		}
+	}
+	catch(const boost::bad_lexical_cast&)
+	{
+		return false;
+	}
+
+	return !values.empty();
+}
+
+/**
+ * @brief Chamber parameter and Paschen sweep: every combination of the axes, one CSV table and one heat map.
+ * @param argc Argument count.
+ * @param argv chamber <pressures Pa> <gaps m> <temperatures K> <energies eV> <cross section>.
+ * @return Exit code.
+ */
+static int runChamberSweep(const int argc, const char** argv)
+{
+	if(argc != 7)
+	{
+		std::cout << "Params\n"
+				  << "\tchamber\n"
+				  << "\t<pressures in Pa>\n"
+				  << "\t<gaps in m>\n"
+				  << "\t<temperatures in K>\n"
+				  << "\t<energies in eV>\n"
+				  << "\t<cross_section>\n"
+				  << "\nEvery axis is a comma separated list, first:last:count or first:last:count:log.\n"
+				  << "\n\nExample: ./PotentialMap chamber 0.1:100:200:log 0.001:0.1:200:log 300,600 1000,10000 1\n";
+		return 0;
+	}
+
+	ChamberGrid grid;
+
+	if(!parseAxis(argv[2], grid.pressures) || !parseAxis(argv[3], grid.gaps) ||
+	   !parseAxis(argv[4], grid.temperatures) || !parseAxis(argv[5], grid.energies))
+	{
+		std::cout << "Unable to understand the sweep axes.\n";
+		return 0;
+	}
+
+	try
+	{
+		grid.cross_section = boost::lexical_cast<double>(argv[6]);
+	}
+	catch(const boost::bad_lexical_cast& ex)
+	{
+		std::cout << "Unable to understand the cross section.\n" << ex.what();
+		return 0;
+	}
+
+	std::cout << "Sweeping " << grid.size() << " points ..." << std::endl;
+
+	ChamberSweep sweep(grid);
+	sweep.run();
+
+	if(sweep.writeCsv("chamber_sweep.csv"))
+	{
+		std::cout << "Table saved to: chamber_sweep.csv" << std::endl;
+	}
+	else
+	{
+		std::cout << "Unable to write chamber_sweep.csv" << std::endl;
+	}
+
+	if(sweep.writeHeatMap("chamber_sweep.png"))
+	{
+		std::cout << "Breakdown voltage map saved to: chamber_sweep.png" << std::endl;
+	}
+
+	return 1;
+}
 
 int main(int argc, const char** argv)
 {
-	if (argc != 7)
+	RenderOptions options{ Palette::Map::HLS, 0, 0 };
+	if (!extractRenderOptions(argc, argv, options))
+	{
+		return 0;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "sweep")
+	{
+		return runSweep(argc, argv, options);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "laplace")
+	{
+		return runLaplace(argc, argv, options);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "progressive")
+	{
+		return runProgressive(argc, argv, options);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "chamber")
+	{
+		return runChamberSweep(argc, argv);
+	}
+
+	if (argc != 7 && argc != 8)
     {
         std::cout << "Params\n"
                   << "\t<number of z-axis slices>\n"
@@ -31,8 +635,15 @@ int main(int argc, const char** argv)
                   << "\t<axis size in mm>\n"
                   << "\t<radius of poissor in mm>\n"
                   << "\t<input voltage (kV)>\n"
+                  << "\t[number of cathode rings, default 3]\n"
                   << "\n\nExample: ./PotentialMap 10 256 5 1 30 2\n"
-				  << "\n\nThe last number is the menu choice. 1 for chamber parameters, 2 for potential map.\n";
+				  << "\n\nThe last number is the menu choice. 1 for chamber parameters, 2 for potential map.\n"
+				  << "\n\nVoltage sweep from a cached distance field: ./PotentialMap sweep 10 256 5 1 10,20,30\n"
+				  << "\n\nSolved Laplace potential: ./PotentialMap laplace 10 256 5 1 30\n"
+				  << "\n\nProgressive previews, coarse to fine: ./PotentialMap progressive 10 1024 5 1 30\n"
+				  << "\n\nChamber parameter and Paschen sweep: ./PotentialMap chamber 0.1:100:200:log 0.001:0.1:200:log 300 1000 1\n"
+				  << "\n\nAll modes take --palette <hls|grey|viridis> and --contours <levels>."
+				  << "\nFor very large slices, --strip <rows> streams each slice to disk strip by strip.\n";
         return 0;
     }
     else
@@ -74,7 +685,8 @@ int main(int argc, const char** argv)
         }
 	}
 
-	int c1, c2, c3, c4, c5;	
+	int c1, c2, c3, c4, c5;
+	int ringCount = 3;
 	
 	try
 	{
@@ -83,6 +695,11 @@ int main(int argc, const char** argv)
 		c3 = boost::lexical_cast<int>(argv[3]);
 		c4 = boost::lexical_cast<int>(argv[4]);
 		c5 = boost::lexical_cast<int>(argv[5]) * 1000;
+
+		if(argc == 8)
+		{
+			ringCount = boost::lexical_cast<int>(argv[7]);
+		}
 	}
 	catch(const boost::bad_lexical_cast& ex)
 	{
@@ -95,141 +712,46 @@ int main(int argc, const char** argv)
 	const int axis_max = c3;
 	const int radius = c4;
 	const int kV = c5;
-	
-	// Find out what each increment in position means (accounting for measurements in mm and not metres).
-	const double z_space = (static_cast< double >(axis_max) / static_cast< double >(z_slices)) / 1000;
-	const double xy_space = (static_cast< double >(axis_max) / static_cast< double >(xy_slices)) / 1000;
-		
-	const int xy_half = xy_slices / 2;
-	
-	double minPotential = std::numeric_limits< double >::max();
-	double maxPotential = std::numeric_limits< double >::min();
-	
-	double z_pos = 0.0;
-
-	for( int z = (z_slices / 2); z < z_slices; z++, z_pos+=z_space)
-	{
-		double x_pos = 0.0;
-		
-		const int top = z_slices - z;
-		const int bottom = z;
-		
-		std::cout << "Calculating slice " << (z - (z_slices / 2)) + 1 << " of " << z_slices / 2 << std::endl;
-		
-		std::string topName = "slice";
-		std::string bottomName = "slice";
-		
-		try
-		{
-			topName += boost::lexical_cast<std::string>(top);
-			bottomName += boost::lexical_cast<std::string>(z_slices - top);
-		}
-		catch(const boost::bad_lexical_cast& ex)
-		{
-			std::cout << "Unable to create name of file for slices << " << top << " and " << bottom << std::endl;
-			std::cout << ex.what();
-		}
-		
-		topName += ".png";
-		bottomName += ".png";
-		
-		boost::gil::rgb8_image_t img(xy_slices, xy_slices);
-		boost::gil::rgb8_view_t vw = boost::gil::view(img);
-			
-		for(int x = 0; x < xy_half + (xy_half % 2); x++, x_pos+=xy_space)
-		{
-			double y_pos = 0.0;
-			
-			for(int y = 0; y < xy_half + (xy_half % 2); y++, y_pos+=xy_space)
-			{				
-				const double potential = PotentialCalulator::calcPotentialAtPoint(
-					x_pos, y_pos, z_pos, radius, kV);
-				minPotential = std::min(minPotential, potential);
-				maxPotential = std::max(maxPotential, potential);
-				
-				int8_t r = 0;
-				int8_t g = 0;
-				int8_t b = 0;
-				
-				ColouriserCreator::colourise(potential, kV, r, g, b);
-				
-				vw(xy_half + x, xy_half + y) = boost::gil::rgb8_pixel_t(r, g, b);
-				vw(xy_half + x, xy_half - y) = boost::gil::rgb8_pixel_t(r, g, b);
-				vw(xy_half - x, xy_half + y) = boost::gil::rgb8_pixel_t(r, g, b);
-				vw(xy_half - x, xy_half - y) = boost::gil::rgb8_pixel_t(r, g, b);
-				
-				y_pos += xy_space;
-			}
-			
-			x_pos += xy_space;
-		}
-		
-		gil::write_view(topName, vw, gil::png_tag());
 
-		if(top != bottom)
-		{
-			gil::write_view(bottomName, vw, gil::png_tag());
-		}
-		
-		z_pos += z_space;
-		
-		for(int x = 0; x < xy_slices; x++)
-		{
-			for(int y = 0; y < xy_slices; y++)
-			{
+	const MapGeometry geometry{ z_slices, xy_slices, axis_max, radius, ringCount };
 
-			}
-		}
-
-		// copy image, lay grid over it
-		gil::rgb8_image_t gridImg(xy_slices, xy_slices);
-		gil::rgb8_view_t gridVw = gil::view(gridImg);
+	const int row_length = geometry.rowLength();
 
-		for(int x = 0; x < xy_slices; x++)
-		{
-			for(int y = 0; y < xy_slices; y++)
-			{
-				gridVw(x, y) = vw(x, y);
-			}
-		}
+	if(ringCount < 1)
+	{
+		std::cout << "Number of cathode rings must be at least 1.\n";
+		return 0;
+	}
 
-		for(int x = 0; x < xy_slices; x++)
-		{
-			for(int y = 0; y < xy_slices; y++)
-			{
-				if(0 == x % 10)
-				{
-					gridVw(x, y) = boost::gil::rgb8_pixel_t(0, 0, 0);
-				}
-				if(0 == y % 10)
-				{
-					gridVw(x, y) = boost::gil::rgb8_pixel_t(0, 0, 0);
-				}
-			}
-		}
+	const std::vector< RingWire > rings = PotentialCalulator::spiralRings(radius, ringCount);
 
-		std::string info = "z slices: " + boost::lexical_cast<std::string>(z_slices) + "\n" +
-							"xy slices: " + boost::lexical_cast<std::string>(xy_slices) + "\n" +
-							"axis size: " + boost::lexical_cast<std::string>(axis_max) + "\n" +
-							"radius: " + boost::lexical_cast<std::string>(radius) + "\n" +
-							"voltage: " + boost::lexical_cast<std::string>(kV) + "\n";
+	double minPotential = 0.0;
+	double maxPotential = 0.0;
 
-		std::string gridName = "grid";
+	const SlicePipeline pipeline = makePipeline(geometry, options);
 
-		try
+	pipeline.run("",
+		[&](const int k, const int firstRow, const int rowCount, float *rows, double &localMin, double &localMax)
 		{
-			gridName += boost::lexical_cast<std::string>(top);
-		}
-		catch(const boost::bad_lexical_cast& ex)
-		{
-			std::cout << "Unable to create name of file for grid << " << top << std::endl;
-			std::cout << ex.what();
-		}
+			const double z_pos = geometry.zPos(k);
+			std::vector< double > column(rowCount);
 
-		gridName += ".png";
+			for(int x = 0; x < row_length; x++)
+			{
+				// one batch call per column of the strip, y_pos = 2 * y * xy_space
+				PotentialCalulator::calcPotentialRow(geometry.xyPos(x), geometry.xyPos(firstRow), 2.0 * geometry.xySpace(), z_pos, rowCount, rings, kV, column.data());
 
-		gil::write_view(gridName, gridVw, gil::png_tag());
-	}
+				for(int r = 0; r < rowCount; r++)
+				{
+					const double potential = column[r];
+					localMin = std::min(localMin, potential);
+					localMax = std::max(localMax, potential);
+
+					rows[r * row_length + x] = static_cast< float >(potential);
+				}
+			}
+		},
+		kV, minPotential, maxPotential);
 
 	std::cout << "Min = " << minPotential << "\n";
 	std::cout << "Max = " << maxPotential << "\n";